@@ -1175,16 +1175,29 @@ class V8_EXPORT ScriptCompiler {
     CachedData& operator=(const CachedData&);
   };
 
+  /**
+   * A task which the embedder may run on a background thread to check a code
+   * cache before it is consumed. Returned by
+   * ScriptCompiler::StartConsumingCodeCache.
+   */
+  class ConsumeCodeCacheTask {
+   public:
+    virtual ~ConsumeCodeCacheTask() {}
+    virtual void Run() = 0;
+  };
+
   /**
    * Source code which can be then compiled to a UnboundScript or Script.
    */
   class Source {
    public:
-    // Source takes ownership of CachedData.
+    // Source takes ownership of CachedData and ConsumeCodeCacheTask.
     V8_INLINE Source(Local<String> source_string, const ScriptOrigin& origin,
-           CachedData* cached_data = NULL);
+                     CachedData* cached_data = NULL,
+                     ConsumeCodeCacheTask* consume_cache_task = NULL);
     V8_INLINE Source(Local<String> source_string,
-                     CachedData* cached_data = NULL);
+                     CachedData* cached_data = NULL,
+                     ConsumeCodeCacheTask* consume_cache_task = NULL);
     V8_INLINE ~Source();
 
     // Ownership of the CachedData or its buffers is *not* transferred to the
@@ -1211,6 +1224,10 @@ class V8_EXPORT ScriptCompiler {
     // set), or hold newly generated cache data (kProduce*Cache flags) are
     // set when calling a compile method.
     CachedData* cached_data;
+
+    // Task which has already checked |cached_data| on a background thread,
+    // see StartConsumingCodeCache.
+    ConsumeCodeCacheTask* consume_cache_task;
   };
 
   /**
@@ -1360,6 +1377,19 @@ class V8_EXPORT ScriptCompiler {
       Isolate* isolate, StreamedSource* source,
       CompileOptions options = kNoCompileOptions);
 
+  /**
+   * Returns a task which checks a code cache, so that the check does not have
+   * to happen on the main thread when the cache is consumed. The user is
+   * responsible for running the task on a background thread, and for passing
+   * it to the Source together with |cached_data| once ConsumeCodeCacheTask::Run
+   * has returned. The script is then compiled with kConsumeCodeCache as usual,
+   * and only the deserialization into the heap remains on the main thread.
+   *
+   * |cached_data| must stay alive until the task is deleted.
+   */
+  static ConsumeCodeCacheTask* StartConsumingCodeCache(
+      Isolate* isolate, const CachedData* cached_data);
+
   /**
    * Compiles a streamed script (bound to current context).
    *
@@ -1396,6 +1426,20 @@ class V8_EXPORT ScriptCompiler {
    */
   static uint32_t CachedDataVersionTag();
 
+  /**
+   * Creates a code cache for a script that has already been compiled, and
+   * possibly run. Unlike the cache produced by kProduceCodeCache, which only
+   * contains the functions compiled eagerly at script compile time, this
+   * cache also contains all functions that have been lazily compiled so far.
+   * It is consumed like any other code cache, with kConsumeCodeCache.
+   *
+   * |source| must be the source string the script was compiled from.
+   * Returns NULL if the cache could not be created. Otherwise the caller
+   * takes ownership of the returned CachedData.
+   */
+  static CachedData* CreateCodeCache(Local<UnboundScript> unbound_script,
+                                     Local<String> source);
+
   /**
    * Compile an ES6 module.
    *
@@ -4445,6 +4489,13 @@ class V8_EXPORT FunctionTemplate : public Template {
       Local<Value> data = Local<Value>(),
       Local<Signature> signature = Local<Signature>(), int length = 0);
 
+  /**
+   * Get a template included in the snapshot by index, see
+   * SnapshotCreator::AddTemplate.
+   */
+  static MaybeLocal<FunctionTemplate> FromSnapshot(Isolate* isolate,
+                                                   size_t index);
+
   /**
    * Creates a function template with a fast handler. If a fast handler is set,
    * the callback cannot be null.
@@ -4620,6 +4671,13 @@ class V8_EXPORT ObjectTemplate : public Template {
       Local<FunctionTemplate> constructor = Local<FunctionTemplate>());
   static V8_DEPRECATED("Use isolate version", Local<ObjectTemplate> New());
 
+  /**
+   * Get a template included in the snapshot by index, see
+   * SnapshotCreator::AddTemplate.
+   */
+  static MaybeLocal<ObjectTemplate> FromSnapshot(Isolate* isolate,
+                                                 size_t index);
+
   /** Creates a new instance of this template.*/
   V8_DEPRECATE_SOON("Use maybe version", Local<Object> NewInstance());
   V8_WARN_UNUSED_RESULT MaybeLocal<Object> NewInstance(Local<Context> context);
@@ -5288,7 +5346,8 @@ class V8_EXPORT Isolate {
           counter_lookup_callback(NULL),
           create_histogram_callback(NULL),
           add_histogram_sample_callback(NULL),
-          array_buffer_allocator(NULL) {}
+          array_buffer_allocator(NULL),
+          external_references(NULL) {}
 
     /**
      * The optional entry_hook allows the host application to provide the
@@ -5336,6 +5395,15 @@ class V8_EXPORT Isolate {
      * store of ArrayBuffers.
      */
     ArrayBuffer::Allocator* array_buffer_allocator;
+
+    /**
+     * Specifies an optional nullptr-terminated array of raw addresses in the
+     * embedder that V8 can match against during serialization and use for
+     * deserialization. This array and its content must stay valid for the
+     * entire lifetime of the isolate. It has to be the same array that was
+     * passed to the SnapshotCreator that created the snapshot_blob.
+     */
+    intptr_t* external_references;
   };
 
 
@@ -6062,6 +6130,67 @@ class V8_EXPORT StartupData {
 };
 
 
+/**
+ * Helper class to create a snapshot data blob that captures the state of
+ * an isolate, including embedder templates, their callbacks and any number
+ * of contexts. Isolates created from the resulting blob start out with
+ * that state, instead of having to set it up again.
+ */
+class V8_EXPORT SnapshotCreator {
+ public:
+  /**
+   * Create and enter an isolate, and set it up for serialization.
+   * The isolate is either created from scratch or from an existing snapshot.
+   * The caller keeps ownership of the argument snapshot.
+   * \param existing_blob existing snapshot from which to create this one.
+   * \param external_references a null-terminated array of external references
+   *        that must be equivalent to CreateParams::external_references. All
+   *        addresses of embedder callbacks reachable from the snapshot have
+   *        to be listed here.
+   */
+  explicit SnapshotCreator(intptr_t* external_references = NULL,
+                           StartupData* existing_blob = NULL);
+
+  ~SnapshotCreator();
+
+  /**
+   * \returns the isolate prepared by the snapshot creator.
+   */
+  Isolate* GetIsolate();
+
+  /**
+   * Add a context to be included in the snapshot blob. The first context
+   * added is used by Context::New, all of them can be retrieved with
+   * Context::FromSnapshot.
+   * \returns the index of the context in the snapshot blob.
+   */
+  size_t AddContext(Local<Context> context);
+
+  /**
+   * Add a template to be included in the snapshot blob. Templates must not
+   * refer to JavaScript objects, for example through their data.
+   * \returns the index of the template in the snapshot blob.
+   */
+  size_t AddTemplate(Local<Template> template_obj);
+
+  /**
+   * Creates a snapshot data blob.
+   * This must not be called from within a handle scope. Compiled function
+   * code is not included, functions are compiled lazily again on first use.
+   * \returns { NULL, 0 } on failure, and a startup snapshot on success. The
+   *        caller acquires ownership of the data array in the return value.
+   */
+  StartupData CreateBlob();
+
+ private:
+  void* data_;
+
+  // Disallow copying and assigning.
+  SnapshotCreator(const SnapshotCreator&);
+  void operator=(const SnapshotCreator&);
+};
+
+
 /**
  * EntropySource is used as a callback function when v8 needs a source
  * of entropy.
@@ -6730,6 +6859,25 @@ class V8_EXPORT Context {
       Local<ObjectTemplate> global_template = Local<ObjectTemplate>(),
       Local<Value> global_object = Local<Value>());
 
+  /**
+   * Create a new context from a (non-default) context snapshot. There
+   * is no way to provide a global template, since the global object is
+   * restored from the snapshot.
+   *
+   * \param isolate See v8::Context::New.
+   *
+   * \param context_snapshot_index The index of the context snapshot to
+   * deserialize from, as returned by SnapshotCreator::AddContext.
+   *
+   * \param extensions See v8::Context::New.
+   *
+   * \param global_object See v8::Context::New.
+   */
+  static MaybeLocal<Context> FromSnapshot(
+      Isolate* isolate, size_t context_snapshot_index,
+      ExtensionConfiguration* extensions = NULL,
+      Local<Value> global_object = Local<Value>());
+
   /**
    * Sets the security token for the context.  To access an object in
    * another context, the security tokens must match.
@@ -7701,22 +7849,24 @@ Local<Value> ScriptOrigin::SourceMapUrl() const { return source_map_url_; }
 
 
 ScriptCompiler::Source::Source(Local<String> string, const ScriptOrigin& origin,
-                               CachedData* data)
+                               CachedData* data, ConsumeCodeCacheTask* task)
     : source_string(string),
       resource_name(origin.ResourceName()),
       resource_line_offset(origin.ResourceLineOffset()),
       resource_column_offset(origin.ResourceColumnOffset()),
       resource_options(origin.Options()),
       source_map_url(origin.SourceMapUrl()),
-      cached_data(data) {}
+      cached_data(data),
+      consume_cache_task(task) {}
 
 
-ScriptCompiler::Source::Source(Local<String> string,
-                               CachedData* data)
-    : source_string(string), cached_data(data) {}
+ScriptCompiler::Source::Source(Local<String> string, CachedData* data,
+                               ConsumeCodeCacheTask* task)
+    : source_string(string), cached_data(data), consume_cache_task(task) {}
 
 
 ScriptCompiler::Source::~Source() {
+  delete consume_cache_task;
   delete cached_data;
 }
 
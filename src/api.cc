@@ -15,6 +15,7 @@
 #include "include/v8-experimental.h"
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
+#include "include/v8-util.h"
 #include "src/api-experimental.h"
 #include "src/api-natives.h"
 #include "src/assert-scope.h"
@@ -364,9 +365,208 @@ class ArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
   virtual void Free(void* data, size_t) { free(data); }
 };
 
+
+// Prepares the heap of the {isolate} for serialization, and serializes it
+// together with the {contexts} into a snapshot blob. The {contexts} are
+// reset before serialization, so that they don't end up as stray roots.
+StartupData SerializeIsolateAndContexts(
+    i::Isolate* isolate, PersistentValueVector<Context>* contexts,
+    i::Snapshot::Metadata metadata) {
+  // If we don't do this then we end up with a stray root pointing at the
+  // context even after we have disposed of the context.
+  isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
+
+  // GC may have cleared weak cells, so compact any WeakFixedArrays
+  // found on the heap.
+  i::HeapIterator iterator(isolate->heap(),
+                           i::HeapIterator::kFilterUnreachable);
+  for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
+    if (o->IsPrototypeInfo()) {
+      i::Object* prototype_users = i::PrototypeInfo::cast(o)->prototype_users();
+      if (prototype_users->IsWeakFixedArray()) {
+        i::WeakFixedArray* array = i::WeakFixedArray::cast(prototype_users);
+        array->Compact<i::JSObject::PrototypeRegistryCompactionCallback>();
+      }
+    } else if (o->IsScript()) {
+      i::Object* shared_list = i::Script::cast(o)->shared_function_infos();
+      if (shared_list->IsWeakFixedArray()) {
+        i::WeakFixedArray* array = i::WeakFixedArray::cast(shared_list);
+        array->Compact<i::WeakFixedArray::NullCallback>();
+      }
+    }
+  }
+
+  int num_contexts = static_cast<int>(contexts->Size());
+  i::List<i::Object*> raw_contexts(num_contexts);
+  {
+    HandleScope scope(reinterpret_cast<Isolate*>(isolate));
+    for (int i = 0; i < num_contexts; i++) {
+      raw_contexts.Add(*v8::Utils::OpenHandle(*contexts->Get(i)));
+    }
+  }
+  contexts->Clear();
+
+  i::SnapshotByteSink snapshot_sink;
+  i::StartupSerializer startup_serializer(
+      isolate, &snapshot_sink,
+      i::FLAG_lazy_deserialization
+          ? i::StartupSerializer::kSerializeBuiltinsLazily
+          : i::StartupSerializer::kSerializeBuiltinsEagerly);
+  startup_serializer.SerializeStrongReferences();
+
+  i::List<i::SnapshotData*> context_snapshots(num_contexts);
+  for (int i = 0; i < num_contexts; i++) {
+    i::SnapshotByteSink context_sink;
+    i::PartialSerializer context_serializer(isolate, &startup_serializer,
+                                            &context_sink);
+    context_serializer.Serialize(&raw_contexts[i]);
+    context_snapshots.Add(new i::SnapshotData(context_serializer));
+  }
+
+  // The lazy builtins may add to the partial snapshot cache, so they have
+  // to be serialized before the weak references.
+  i::List<i::SnapshotData*> builtin_snapshots(i::Builtins::builtin_count);
+  for (int i = 0; i < i::Builtins::builtin_count; i++) {
+    i::SnapshotData* builtin_snapshot = NULL;
+    if (startup_serializer.IsSerializedLazily(i)) {
+      i::SnapshotByteSink builtin_sink;
+      i::BuiltinSerializer builtin_serializer(isolate, &startup_serializer,
+                                              &builtin_sink);
+      builtin_serializer.Serialize(static_cast<i::Builtins::Name>(i));
+      builtin_snapshot = new i::SnapshotData(builtin_serializer);
+    }
+    builtin_snapshots.Add(builtin_snapshot);
+  }
+  startup_serializer.SerializeWeakReferencesAndDeferred();
+
+  i::SnapshotData startup_snapshot(startup_serializer);
+  StartupData result = i::Snapshot::CreateSnapshotBlob(
+      &startup_snapshot, &context_snapshots, &builtin_snapshots, metadata);
+  for (int i = 0; i < num_contexts; i++) delete context_snapshots[i];
+  for (int i = 0; i < i::Builtins::builtin_count; i++) {
+    delete builtin_snapshots[i];
+  }
+  return result;
+}
+
+
+struct SnapshotCreatorData {
+  explicit SnapshotCreatorData(Isolate* isolate)
+      : isolate_(isolate),
+        contexts_(isolate),
+        templates_(isolate),
+        created_(false) {}
+
+  static SnapshotCreatorData* cast(void* data) {
+    return reinterpret_cast<SnapshotCreatorData*>(data);
+  }
+
+  ArrayBufferAllocator allocator_;
+  Isolate* isolate_;
+  PersistentValueVector<Context> contexts_;
+  PersistentValueVector<Template> templates_;
+  bool created_;
+};
+
 }  // namespace
 
 
+SnapshotCreator::SnapshotCreator(intptr_t* external_references,
+                                 StartupData* existing_snapshot) {
+  i::Isolate* internal_isolate = new i::Isolate(true);
+  Isolate* isolate = reinterpret_cast<Isolate*>(internal_isolate);
+  SnapshotCreatorData* data = new SnapshotCreatorData(isolate);
+  internal_isolate->set_array_buffer_allocator(&data->allocator_);
+  internal_isolate->set_api_external_references(external_references);
+  isolate->Enter();
+  if (existing_snapshot) {
+    internal_isolate->set_snapshot_blob(existing_snapshot);
+    CHECK(i::Snapshot::Initialize(internal_isolate));
+  } else {
+    internal_isolate->Init(NULL);
+  }
+  data_ = data;
+}
+
+
+SnapshotCreator::~SnapshotCreator() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  Isolate* isolate = data->isolate_;
+  // The persistent handles have to go away before the isolate does.
+  data->contexts_.Clear();
+  data->templates_.Clear();
+  isolate->Exit();
+  isolate->Dispose();
+  delete data;
+}
+
+
+Isolate* SnapshotCreator::GetIsolate() {
+  return SnapshotCreatorData::cast(data_)->isolate_;
+}
+
+
+size_t SnapshotCreator::AddContext(Local<Context> context) {
+  DCHECK(!context.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  CHECK_EQ(data->isolate_, context->GetIsolate());
+  size_t index = data->contexts_.Size();
+  data->contexts_.Append(context);
+  return index;
+}
+
+
+size_t SnapshotCreator::AddTemplate(Local<Template> template_obj) {
+  DCHECK(!template_obj.IsEmpty());
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  DCHECK(!data->created_);
+  size_t index = data->templates_.Size();
+  data->templates_.Append(template_obj);
+  return index;
+}
+
+
+StartupData SnapshotCreator::CreateBlob() {
+  SnapshotCreatorData* data = SnapshotCreatorData::cast(data_);
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(data->isolate_);
+  DCHECK(!data->created_);
+  StartupData result = {NULL, 0};
+  // We need at least one context to serve as the default context.
+  if (data->contexts_.Size() == 0) return result;
+  base::ElapsedTimer timer;
+  timer.Start();
+
+  // The templates are kept alive by a root, so that they are serialized
+  // as part of the startup snapshot.
+  {
+    HandleScope scope(data->isolate_);
+    int num_templates = static_cast<int>(data->templates_.Size());
+    i::Handle<i::FixedArray> templates =
+        isolate->factory()->NewFixedArray(num_templates, i::TENURED);
+    for (int i = 0; i < num_templates; i++) {
+      templates->set(i, *v8::Utils::OpenHandle(*data->templates_.Get(i)));
+    }
+    isolate->heap()->SetSerializedTemplates(*templates);
+    data->templates_.Clear();
+  }
+
+  // The embedder state cannot be recreated without the snapshot, so this
+  // has to be treated like a snapshot with an embedded script.
+  i::Snapshot::Metadata metadata;
+  metadata.set_embeds_script(true);
+  result = SerializeIsolateAndContexts(isolate, &data->contexts_, metadata);
+  data->created_ = true;
+
+  if (i::FLAG_profile_deserialization) {
+    i::PrintF("Creating snapshot took %0.3f ms\n",
+              timer.Elapsed().InMillisecondsF());
+  }
+  timer.Stop();
+  return result;
+}
+
+
 StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
   i::Isolate* internal_isolate = new i::Isolate(true);
   ArrayBufferAllocator allocator;
@@ -378,57 +578,22 @@ StartupData V8::CreateSnapshotDataBlob(const char* custom_source) {
     timer.Start();
     Isolate::Scope isolate_scope(isolate);
     internal_isolate->Init(NULL);
-    Persistent<Context> context;
+    PersistentValueVector<Context> contexts(isolate);
     i::Snapshot::Metadata metadata;
     {
       HandleScope handle_scope(isolate);
       Local<Context> new_context = Context::New(isolate);
-      context.Reset(isolate, new_context);
+      bool success = true;
       if (custom_source != NULL) {
         metadata.set_embeds_script(true);
         Context::Scope context_scope(new_context);
-        if (!RunExtraCode(isolate, new_context, custom_source)) context.Reset();
+        success = RunExtraCode(isolate, new_context, custom_source);
       }
+      if (success) contexts.Append(new_context);
     }
-    if (!context.IsEmpty()) {
-      // If we don't do this then we end up with a stray root pointing at the
-      // context even after we have disposed of the context.
-      internal_isolate->heap()->CollectAllAvailableGarbage("mksnapshot");
-
-      // GC may have cleared weak cells, so compact any WeakFixedArrays
-      // found on the heap.
-      i::HeapIterator iterator(internal_isolate->heap(),
-                               i::HeapIterator::kFilterUnreachable);
-      for (i::HeapObject* o = iterator.next(); o != NULL; o = iterator.next()) {
-        if (o->IsPrototypeInfo()) {
-          i::Object* prototype_users =
-              i::PrototypeInfo::cast(o)->prototype_users();
-          if (prototype_users->IsWeakFixedArray()) {
-            i::WeakFixedArray* array = i::WeakFixedArray::cast(prototype_users);
-            array->Compact<i::JSObject::PrototypeRegistryCompactionCallback>();
-          }
-        } else if (o->IsScript()) {
-          i::Object* shared_list = i::Script::cast(o)->shared_function_infos();
-          if (shared_list->IsWeakFixedArray()) {
-            i::WeakFixedArray* array = i::WeakFixedArray::cast(shared_list);
-            array->Compact<i::WeakFixedArray::NullCallback>();
-          }
-        }
-      }
-
-      i::Object* raw_context = *v8::Utils::OpenPersistent(context);
-      context.Reset();
-
-      i::SnapshotByteSink snapshot_sink;
-      i::StartupSerializer ser(internal_isolate, &snapshot_sink);
-      ser.SerializeStrongReferences();
-
-      i::SnapshotByteSink context_sink;
-      i::PartialSerializer context_ser(internal_isolate, &ser, &context_sink);
-      context_ser.Serialize(&raw_context);
-      ser.SerializeWeakReferencesAndDeferred();
-
-      result = i::Snapshot::CreateSnapshotBlob(ser, context_ser, metadata);
+    if (contexts.Size() > 0) {
+      result = SerializeIsolateAndContexts(internal_isolate, &contexts,
+                                           metadata);
     }
     if (i::FLAG_profile_deserialization) {
       i::PrintF("Creating snapshot took %0.3f ms\n",
@@ -1037,9 +1202,6 @@ Local<FunctionTemplate> FunctionTemplate::New(Isolate* isolate,
                                               v8::Local<Signature> signature,
                                               int length) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // function templates when the isolate is created for serialization.
-  DCHECK(!i_isolate->serializer_enabled());
   LOG_API(i_isolate, "FunctionTemplate::New");
   ENTER_V8(i_isolate);
   return FunctionTemplateNew(i_isolate, callback, nullptr, data, signature,
@@ -1047,6 +1209,21 @@ Local<FunctionTemplate> FunctionTemplate::New(Isolate* isolate,
 }
 
 
+MaybeLocal<FunctionTemplate> FunctionTemplate::FromSnapshot(Isolate* isolate,
+                                                            size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  if (index < static_cast<size_t>(templates->length())) {
+    i::Object* info = templates->get(static_cast<int>(index));
+    if (info->IsFunctionTemplateInfo()) {
+      return Utils::ToLocal(i::Handle<i::FunctionTemplateInfo>(
+          i::FunctionTemplateInfo::cast(info), i_isolate));
+    }
+  }
+  return MaybeLocal<FunctionTemplate>();
+}
+
+
 Local<FunctionTemplate> FunctionTemplate::NewWithFastHandler(
     Isolate* isolate, FunctionCallback callback,
     experimental::FastAccessorBuilder* fast_handler, v8::Local<Value> data,
@@ -1054,7 +1231,6 @@ Local<FunctionTemplate> FunctionTemplate::NewWithFastHandler(
   // TODO(vogelheim): 'fast_handler' should have a more specific type than
   // Local<Value>.
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
-  DCHECK(!i_isolate->serializer_enabled());
   LOG_API(i_isolate, "FunctionTemplate::NewWithFastHandler");
   ENTER_V8(i_isolate);
   return FunctionTemplateNew(i_isolate, callback, fast_handler, data, signature,
@@ -1227,11 +1403,23 @@ Local<ObjectTemplate> ObjectTemplate::New() {
 }
 
 
+MaybeLocal<ObjectTemplate> ObjectTemplate::FromSnapshot(Isolate* isolate,
+                                                        size_t index) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
+  i::FixedArray* templates = i_isolate->heap()->serialized_templates();
+  if (index < static_cast<size_t>(templates->length())) {
+    i::Object* info = templates->get(static_cast<int>(index));
+    if (info->IsObjectTemplateInfo()) {
+      return Utils::ToLocal(i::Handle<i::ObjectTemplateInfo>(
+          i::ObjectTemplateInfo::cast(info), i_isolate));
+    }
+  }
+  return MaybeLocal<ObjectTemplate>();
+}
+
+
 Local<ObjectTemplate> ObjectTemplate::New(
     i::Isolate* isolate, v8::Local<FunctionTemplate> constructor) {
-  // Changes to the environment cannot be captured in the snapshot. Expect no
-  // object templates when the isolate is created for serialization.
-  DCHECK(!isolate->serializer_enabled());
   LOG_API(isolate, "ObjectTemplate::New");
   ENTER_V8(isolate);
   i::Handle<i::Struct> struct_obj =
@@ -1751,7 +1939,15 @@ MaybeLocal<UnboundScript> ScriptCompiler::CompileUnboundInternal(
   }
 
   i::ScriptData* script_data = NULL;
-  if (options == kConsumeParserCache || options == kConsumeCodeCache) {
+  if (options == kConsumeCodeCache && source->consume_cache_task != NULL) {
+    DCHECK(source->cached_data);
+    // The data has been copied and checked on a background thread already,
+    // unless the embedder never ran the task.
+    script_data = static_cast<i::ConsumeCodeCacheTask*>(
+                      source->consume_cache_task)->ReleaseScriptData();
+  }
+  if (script_data == NULL &&
+      (options == kConsumeParserCache || options == kConsumeCodeCache)) {
     DCHECK(source->cached_data);
     // ScriptData takes care of pointer-aligning the data.
     script_data = new i::ScriptData(source->cached_data->data,
@@ -2008,6 +2204,13 @@ ScriptCompiler::ScriptStreamingTask* ScriptCompiler::StartStreamingScript(
 }
 
 
+ScriptCompiler::ConsumeCodeCacheTask* ScriptCompiler::StartConsumingCodeCache(
+    Isolate* v8_isolate, const CachedData* cached_data) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(v8_isolate);
+  return new i::ConsumeCodeCacheTask(isolate, cached_data);
+}
+
+
 MaybeLocal<Script> ScriptCompiler::Compile(Local<Context> context,
                                            StreamedSource* v8_source,
                                            Local<String> full_source_string,
@@ -2072,6 +2275,28 @@ Local<Script> ScriptCompiler::Compile(Isolate* v8_isolate,
 }
 
 
+ScriptCompiler::CachedData* ScriptCompiler::CreateCodeCache(
+    Local<UnboundScript> unbound_script, Local<String> source) {
+  i::Handle<i::SharedFunctionInfo> shared =
+      i::Handle<i::SharedFunctionInfo>::cast(
+          Utils::OpenHandle(*unbound_script));
+  i::Isolate* isolate = shared->GetIsolate();
+  LOG_API(isolate, "v8::ScriptCompiler::CreateCodeCache");
+  ENTER_V8(isolate);
+  // Don't try to produce any kind of cache when the debugger is loaded.
+  if (isolate->debug()->is_loaded()) return NULL;
+  i::HandleScope scope(isolate);
+  i::ScriptData* script_data =
+      i::Compiler::CreateCodeCache(shared, Utils::OpenHandle(*source));
+  if (script_data == NULL) return NULL;
+  CachedData* result = new CachedData(
+      script_data->data(), script_data->length(), CachedData::BufferOwned);
+  script_data->ReleaseDataOwnership();
+  delete script_data;
+  return result;
+}
+
+
 uint32_t ScriptCompiler::CachedDataVersionTag() {
   return static_cast<uint32_t>(base::hash_combine(
       internal::Version::Hash(), internal::FlagList::Hash(),
@@ -5447,7 +5672,7 @@ const char* v8::V8::GetVersion() {
 static i::Handle<i::Context> CreateEnvironment(
     i::Isolate* isolate, v8::ExtensionConfiguration* extensions,
     v8::Local<ObjectTemplate> global_template,
-    v8::Local<Value> maybe_global_proxy) {
+    v8::Local<Value> maybe_global_proxy, size_t context_snapshot_index) {
   i::Handle<i::Context> env;
 
   // Enter V8 via an ENTER_V8 scope.
@@ -5492,7 +5717,8 @@ static i::Handle<i::Context> CreateEnvironment(
     }
     // Create the environment.
     env = isolate->bootstrapper()->CreateEnvironment(
-        maybe_proxy, proxy_template, extensions);
+        maybe_proxy, proxy_template, extensions, i::FULL_CONTEXT,
+        context_snapshot_index);
 
     // Restore the access check info on the global template.
     if (!global_template.IsEmpty()) {
@@ -5509,17 +5735,19 @@ static i::Handle<i::Context> CreateEnvironment(
   return env;
 }
 
-Local<Context> v8::Context::New(v8::Isolate* external_isolate,
-                                v8::ExtensionConfiguration* extensions,
-                                v8::Local<ObjectTemplate> global_template,
-                                v8::Local<Value> global_object) {
+static Local<Context> NewContext(v8::Isolate* external_isolate,
+                                 v8::ExtensionConfiguration* extensions,
+                                 v8::Local<ObjectTemplate> global_template,
+                                 v8::Local<Value> global_object,
+                                 size_t context_snapshot_index) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(external_isolate);
   LOG_API(isolate, "Context::New");
   i::HandleScope scope(isolate);
   ExtensionConfiguration no_extensions;
   if (extensions == NULL) extensions = &no_extensions;
   i::Handle<i::Context> env =
-      CreateEnvironment(isolate, extensions, global_template, global_object);
+      CreateEnvironment(isolate, extensions, global_template, global_object,
+                        context_snapshot_index);
   if (env.is_null()) {
     if (isolate->has_pending_exception()) {
       isolate->OptionalRescheduleException(true);
@@ -5530,6 +5758,28 @@ Local<Context> v8::Context::New(v8::Isolate* external_isolate,
 }
 
 
+Local<Context> v8::Context::New(v8::Isolate* external_isolate,
+                                v8::ExtensionConfiguration* extensions,
+                                v8::Local<ObjectTemplate> global_template,
+                                v8::Local<Value> global_object) {
+  return NewContext(external_isolate, extensions, global_template,
+                    global_object, 0);
+}
+
+
+MaybeLocal<Context> v8::Context::FromSnapshot(
+    v8::Isolate* external_isolate, size_t context_snapshot_index,
+    v8::ExtensionConfiguration* extensions, v8::Local<Value> global_object) {
+  i::Isolate* isolate = reinterpret_cast<i::Isolate*>(external_isolate);
+  if (!isolate->initialized_from_snapshot() ||
+      !i::Snapshot::HasContextSnapshot(isolate, context_snapshot_index)) {
+    return MaybeLocal<Context>();
+  }
+  return NewContext(external_isolate, extensions, Local<ObjectTemplate>(),
+                    global_object, context_snapshot_index);
+}
+
+
 void v8::Context::SetSecurityToken(Local<Value> token) {
   i::Handle<i::Context> env = Utils::OpenHandle(this);
   i::Handle<i::Object> token_handle = Utils::OpenHandle(*token);
@@ -7153,6 +7403,7 @@ Isolate* Isolate::New(const Isolate::CreateParams& params) {
   Isolate* v8_isolate = reinterpret_cast<Isolate*>(isolate);
   CHECK(params.array_buffer_allocator != NULL);
   isolate->set_array_buffer_allocator(params.array_buffer_allocator);
+  isolate->set_api_external_references(params.external_references);
   if (params.snapshot_blob != NULL) {
     isolate->set_snapshot_blob(params.snapshot_blob);
   } else {
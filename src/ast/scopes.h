@@ -244,6 +244,11 @@ class Scope: public ZoneObject {
   // Inform the scope that the corresponding code contains an eval call.
   void RecordEvalCall() { scope_calls_eval_ = true; }
 
+  // Inform the scope that an inner scope may access any of its variables, as
+  // if it called eval. Used for inner functions that are skipped without
+  // resolving their variables.
+  void RecordInnerScopeEvalCall() { inner_scope_calls_eval_ = true; }
+
   // Inform the scope that the corresponding code uses "arguments".
   void RecordArgumentsUsage() { scope_uses_arguments_ = true; }
 
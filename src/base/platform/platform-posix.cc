@@ -274,14 +274,17 @@ class PosixMemoryMappedFile final : public OS::MemoryMappedFile {
 
 
 // static
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
-  if (FILE* file = fopen(name, "r+")) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                 FileMode mode) {
+  const bool read_only = mode == FileMode::kReadOnly;
+  if (FILE* file = fopen(name, read_only ? "r" : "r+")) {
     if (fseek(file, 0, SEEK_END) == 0) {
       long size = ftell(file);  // NOLINT(runtime/int)
-      if (size >= 0) {
-        void* const memory =
-            mmap(OS::GetRandomMmapAddr(), size, PROT_READ | PROT_WRITE,
-                 MAP_SHARED, fileno(file), 0);
+      if (size > 0) {
+        int prot = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        int flags = read_only ? MAP_PRIVATE : MAP_SHARED;
+        void* const memory = mmap(OS::GetRandomMmapAddr(), size, prot, flags,
+                                  fileno(file), 0);
         if (memory != MAP_FAILED) {
           return new PosixMemoryMappedFile(file, memory, size);
         }
@@ -872,21 +872,29 @@ class Win32MemoryMappedFile final : public OS::MemoryMappedFile {
 
 
 // static
-OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name) {
+OS::MemoryMappedFile* OS::MemoryMappedFile::open(const char* name,
+                                                 FileMode mode) {
+  const bool read_only = mode == FileMode::kReadOnly;
   // Open a physical file
-  HANDLE file = CreateFileA(name, GENERIC_READ | GENERIC_WRITE,
+  HANDLE file = CreateFileA(
+      name, read_only ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
       FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
   if (file == INVALID_HANDLE_VALUE) return NULL;
 
   DWORD size = GetFileSize(file, NULL);
 
   // Create a file mapping for the physical file
-  HANDLE file_mapping =
-      CreateFileMapping(file, NULL, PAGE_READWRITE, 0, size, NULL);
-  if (file_mapping == NULL) return NULL;
+  HANDLE file_mapping = CreateFileMapping(
+      file, NULL, read_only ? PAGE_READONLY : PAGE_READWRITE, 0, size, NULL);
+  if (file_mapping == NULL) {
+    CloseHandle(file);
+    return NULL;
+  }
 
   // Map a view of the file into memory
-  void* memory = MapViewOfFile(file_mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  void* memory = MapViewOfFile(
+      file_mapping, read_only ? FILE_MAP_READ : FILE_MAP_ALL_ACCESS, 0, 0,
+      size);
   return new Win32MemoryMappedFile(file, file_mapping, memory, size);
 }
 
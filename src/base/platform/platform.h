@@ -214,7 +214,13 @@ class OS {
     virtual void* memory() const = 0;
     virtual size_t size() const = 0;
 
-    static MemoryMappedFile* open(const char* name);
+    // Files opened with kReadOnly are mapped private and read-only. Since the
+    // pages are never written, they stay backed by the page cache and are
+    // shared between processes.
+    enum class FileMode { kReadOnly, kReadWrite };
+
+    static MemoryMappedFile* open(const char* name,
+                                  FileMode mode = FileMode::kReadWrite);
     static MemoryMappedFile* create(const char* name, size_t size,
                                     void* initial);
   };
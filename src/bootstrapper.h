@@ -76,11 +76,14 @@ class Bootstrapper final {
 
   // Creates a JavaScript Global Context with initial object graph.
   // The returned value is a global handle casted to V8Environment*.
+  // The {context_snapshot_index} selects the context snapshot to start
+  // from, if the isolate was initialized from a snapshot.
   Handle<Context> CreateEnvironment(
       MaybeHandle<JSGlobalProxy> maybe_global_proxy,
       v8::Local<v8::ObjectTemplate> global_object_template,
       v8::ExtensionConfiguration* extensions,
-      ContextType context_type = FULL_CONTEXT);
+      ContextType context_type = FULL_CONTEXT,
+      size_t context_snapshot_index = 0);
 
   // Detach the environment from its outer global object.
   void DetachGlobal(Handle<Context> env);
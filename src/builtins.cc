@@ -19,6 +19,7 @@
 #include "src/profiler/cpu-profiler.h"
 #include "src/property-descriptor.h"
 #include "src/prototype.h"
+#include "src/snapshot/snapshot.h"
 #include "src/string-builder.h"
 #include "src/vm-state-inl.h"
 
@@ -2527,7 +2528,7 @@ static void Generate_FrameDropper_LiveEdit(MacroAssembler* masm) {
 }
 
 
-Builtins::Builtins() : initialized_(false) {
+Builtins::Builtins() : isolate_(NULL), initialized_(false) {
   memset(builtins_, 0, sizeof(builtins_[0]) * builtin_count);
   memset(names_, 0, sizeof(names_[0]) * builtin_count);
 }
@@ -2623,6 +2624,7 @@ void Builtins::InitBuiltinFunctionTable() {
 
 void Builtins::SetUp(Isolate* isolate, bool create_heap_objects) {
   DCHECK(!initialized_);
+  isolate_ = isolate;
 
   // Create a scope for the handles in the builtins.
   HandleScope scope(isolate);
@@ -2703,6 +2705,7 @@ const char* Builtins::Lookup(byte* pc) {
   // may be called during initialization (disassembler!)
   if (initialized_) {
     for (int i = 0; i < builtin_count; i++) {
+      if (!builtins_[i]->IsHeapObject()) continue;
       Code* entry = Code::cast(builtins_[i]);
       if (entry->contains(pc)) {
         return names_[i];
@@ -2713,6 +2716,54 @@ const char* Builtins::Lookup(byte* pc) {
 }
 
 
+bool Builtins::IsLazy(int index) {
+  DCHECK_LE(0, index);
+  DCHECK_LT(index, builtin_count);
+  switch (index) {
+    // These are referenced from the runtime in places that must not
+    // allocate, e.g. when clearing the stub cache during GC, or are needed
+    // to set up the API and the restricted function properties.
+    case kIllegal:
+    case kEmptyFunction:
+    case kHandleApiCall:
+    case kHandleApiCallConstruct:
+    case kHandleApiCallAsFunction:
+    case kHandleApiCallAsConstructor:
+    case kRestrictedFunctionPropertiesThrower:
+    case kRestrictedStrictArgumentsPropertiesThrower:
+      return false;
+    default:
+      // The C++ builtins come first in the builtins table.
+      return index < cfunction_count;
+  }
+}
+
+
+Code* Builtins::DeserializeLazy(Name name) {
+  DCHECK(initialized_);
+  DCHECK(IsLazy(name));
+  HandleScope scope(isolate_);
+  Handle<Code> code = Snapshot::DeserializeBuiltin(isolate_, name);
+  DCHECK_EQ(*code, builtins_[name]);
+  PROFILE(isolate_, CodeCreateEvent(Logger::BUILTIN_TAG, *code, names_[name]));
+  return *code;
+}
+
+
+void Builtins::set_builtin(int index, Code* code) {
+  DCHECK(!is_deserialized(static_cast<Name>(index)));
+  builtins_[index] = code;
+}
+
+
+void Builtins::DeserializeLazyBuiltins() {
+  for (int i = 0; i < builtin_count; i++) {
+    Name name = static_cast<Name>(i);
+    if (!is_deserialized(name)) DeserializeLazy(name);
+  }
+}
+
+
 void Builtins::Generate_InterruptCheck(MacroAssembler* masm) {
   masm->TailCallRuntime(Runtime::kInterrupt, 0, 1);
 }
@@ -2723,11 +2774,16 @@ void Builtins::Generate_StackCheck(MacroAssembler* masm) {
 }
 
 
+Handle<Code> Builtins::builtin_handle(Name name) {
+  if (!is_deserialized(name)) DeserializeLazy(name);
+  Code** code_address = reinterpret_cast<Code**>(builtin_address(name));
+  return Handle<Code>(code_address);
+}
+
+
 #define DEFINE_BUILTIN_ACCESSOR_C(name, ignore)               \
 Handle<Code> Builtins::name() {                               \
-  Code** code_address =                                       \
-      reinterpret_cast<Code**>(builtin_address(k##name));     \
-  return Handle<Code>(code_address);                          \
+  return builtin_handle(k##name);                             \
 }
 #define DEFINE_BUILTIN_ACCESSOR_A(name, kind, state, extra) \
 Handle<Code> Builtins::name() {                             \
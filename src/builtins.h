@@ -237,6 +237,12 @@ class Builtins {
   // Disassembler support.
   const char* Lookup(byte* pc);
 
+  // Returns true if the builtin with the given {index} may be left out of
+  // the startup snapshot proper and deserialized on first use instead. This
+  // is only the case for the C++ builtins that implement library functions,
+  // which are neither referenced from generated code nor needed during GC.
+  static bool IsLazy(int index);
+
   enum Name {
 #define DEF_ENUM_C(name, ignore) k##name,
 #define DEF_ENUM_A(name, kind, state, extra) k##name,
@@ -272,12 +278,31 @@ class Builtins {
   Handle<Code> CallFunction(ConvertReceiverMode = ConvertReceiverMode::kAny);
   Handle<Code> Call(ConvertReceiverMode = ConvertReceiverMode::kAny);
 
+  // Never allocates, so lazy builtins must have been deserialized already,
+  // e.g. through builtin_handle() or the handle accessors above.
   Code* builtin(Name name) {
     // Code::cast cannot be used here since we access builtins
     // during the marking phase of mark sweep. See IC::Clear.
+    DCHECK(is_deserialized(name));
     return reinterpret_cast<Code*>(builtins_[name]);
   }
 
+  // Deserializes the builtin with the given {name} first if it is lazy,
+  // which may trigger a GC.
+  Handle<Code> builtin_handle(Name name);
+
+  // Lazy builtins are represented by a Smi in the builtins table until
+  // they are deserialized from the snapshot.
+  bool is_deserialized(Name name) const {
+    return !HAS_SMI_TAG(builtins_[name]);
+  }
+
+  // Called by the deserializer for every builtin code object it creates.
+  void set_builtin(int index, Code* code);
+
+  // Deserializes all builtins that have not been deserialized yet.
+  void DeserializeLazyBuiltins();
+
   Address builtin_address(Name name) {
     return reinterpret_cast<Address>(&builtins_[name]);
   }
@@ -304,6 +329,12 @@ class Builtins {
   // The external C++ functions called from the code.
   static Address const c_functions_[cfunction_count];
 
+  // Deserializes the builtin with the given {name} from the snapshot and
+  // installs it in the builtins table. This may trigger a GC.
+  Code* DeserializeLazy(Name name);
+
+  Isolate* isolate_;
+
   // Note: These are always Code objects, but to conform with
   // IterateBuiltins() above which assumes Object**'s for the callback
   // function f, we use an Object* array here.
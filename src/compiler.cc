@@ -1191,10 +1191,12 @@ static Handle<SharedFunctionInfo> CompileToplevel(CompilationInfo* info) {
       // non-NULL). If compiling for debugging, we may eagerly compile inner
       // functions, so do not parse lazily in that case.
       ScriptCompiler::CompileOptions options = parse_info->compile_options();
+      // The same holds if inner functions are selected for eager compilation.
       bool parse_allow_lazy = (options == ScriptCompiler::kConsumeParserCache ||
                                String::cast(script->source())->length() >
                                    FLAG_min_preparse_length) &&
-                              !info->is_debug();
+                              !info->is_debug() &&
+                              info->eager_function_positions() == nullptr;
 
       parse_info->set_allow_lazy_parsing(parse_allow_lazy);
       if (!parse_allow_lazy &&
@@ -1481,6 +1483,55 @@ Handle<SharedFunctionInfo> Compiler::CompileScript(
 }
 
 
+ScriptData* Compiler::CreateCodeCache(Handle<SharedFunctionInfo> toplevel,
+                                      Handle<String> source) {
+  Isolate* isolate = toplevel->GetIsolate();
+  DCHECK(toplevel->is_toplevel());
+  Handle<Script> old_script(Script::cast(toplevel->script()), isolate);
+
+  // Collect the inner functions that have been compiled so far.
+  List<int> compiled_positions;
+  {
+    WeakFixedArray::Iterator iterator(old_script->shared_function_infos());
+    SharedFunctionInfo* shared;
+    while ((shared = iterator.Next<SharedFunctionInfo>())) {
+      if (shared != *toplevel && shared->is_compiled()) {
+        compiled_positions.Add(shared->start_position());
+      }
+    }
+  }
+  compiled_positions.Sort();
+
+  // The existing code cannot be serialized as is: it has been compiled
+  // without reloc info for serialization, and it has collected type feedback
+  // that refers to context-specific objects. Compile a fresh copy instead.
+  Handle<Script> script = isolate->factory()->NewScript(source);
+  script->set_name(old_script->name());
+  script->set_line_offset(old_script->line_offset());
+  script->set_column_offset(old_script->column_offset());
+  script->set_origin_options(old_script->origin_options());
+  script->set_source_mapping_url(old_script->source_mapping_url());
+
+  Zone zone;
+  ParseInfo parse_info(&zone, script);
+  CompilationInfo info(&parse_info);
+  parse_info.set_global();
+  parse_info.set_context(isolate->native_context());
+  parse_info.set_language_mode(toplevel->language_mode());
+  info.PrepareForSerializing();
+  info.set_eager_function_positions(&compiled_positions);
+
+  Handle<SharedFunctionInfo> result = CompileToplevel(&info);
+  if (result.is_null()) {
+    isolate->clear_pending_exception();
+    return NULL;
+  }
+
+  HistogramTimerScope histogram_timer(isolate->counters()->compile_serialize());
+  return CodeSerializer::Serialize(isolate, result, source);
+}
+
+
 Handle<SharedFunctionInfo> Compiler::CompileStreamedScript(
     Handle<Script> script, ParseInfo* parse_info, int source_length) {
   Isolate* isolate = script->GetIsolate();
@@ -1538,6 +1589,7 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
   parse_info.set_scope(literal->scope());
   parse_info.set_language_mode(literal->scope()->language_mode());
   if (outer_info->will_serialize()) info.PrepareForSerializing();
+  info.set_eager_function_positions(outer_info->eager_function_positions());
   if (outer_info->is_first_compile()) info.MarkAsFirstCompile();
   if (outer_info->is_debug()) info.MarkAsDebug();
 
@@ -1559,6 +1611,11 @@ Handle<SharedFunctionInfo> Compiler::GetSharedFunctionInfo(
                     (!info.is_debug() || allow_lazy_without_ctx);
 
   bool lazy = FLAG_lazy && allow_lazy && !literal->should_eager_compile();
+  const List<int>* eager_positions = outer_info->eager_function_positions();
+  if (lazy && eager_positions != nullptr &&
+      SortedListBSearch(*eager_positions, literal->start_position()) >= 0) {
+    lazy = false;
+  }
 
   // Generate code
   Handle<ScopeInfo> scope_info;
@@ -218,6 +218,16 @@ class CompilationInfo {
 
   bool will_serialize() const { return GetFlag(kSerializing); }
 
+  // Sorted start positions of inner functions that are compiled eagerly,
+  // even if they would otherwise be compiled lazily. Inner compilations
+  // inherit the list from their outer function.
+  void set_eager_function_positions(const List<int>* positions) {
+    eager_function_positions_ = positions;
+  }
+  const List<int>* eager_function_positions() const {
+    return eager_function_positions_;
+  }
+
   void MarkAsFunctionContextSpecializing() {
     SetFlag(kFunctionContextSpecializing);
   }
@@ -519,6 +529,8 @@ class CompilationInfo {
   // The current OSR frame for specialization or {nullptr}.
   JavaScriptFrame* osr_frame_ = nullptr;
 
+  const List<int>* eager_function_positions_ = nullptr;
+
   const char* debug_name_;
 
   DISALLOW_COPY_AND_ASSIGN(CompilationInfo);
@@ -673,6 +685,13 @@ class Compiler : public AllStatic {
       ScriptCompiler::CompileOptions compile_options,
       NativesFlag is_natives_code, bool is_module);
 
+  // Create a code cache for an already compiled script. The script is compiled
+  // again for serialization, and all inner functions that have been compiled
+  // so far are compiled eagerly, so that the cache covers them as well.
+  // Returns NULL if the script could not be compiled.
+  static ScriptData* CreateCodeCache(Handle<SharedFunctionInfo> toplevel,
+                                     Handle<String> source);
+
   static Handle<SharedFunctionInfo> CompileStreamedScript(Handle<Script> script,
                                                           ParseInfo* info,
                                                           int source_length);
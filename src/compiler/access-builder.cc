@@ -32,6 +32,22 @@ FieldAccess AccessBuilder::ForHeapNumberValue() {
 }
 
 
+// static
+FieldAccess AccessBuilder::ForSimd128Lane(int lane, int lane_count, Type* type,
+                                          MachineType machine_type) {
+  int const lane_size = 1 << ElementSizeLog2Of(machine_type.representation());
+  DCHECK(0 <= lane && lane < lane_count);
+  DCHECK_EQ(kSimd128Size, lane_count * lane_size);
+#if defined(V8_TARGET_BIG_ENDIAN)
+  lane = lane_count - lane - 1;
+#endif
+  int offset = Simd128Value::kValueOffset + lane * lane_size;
+  FieldAccess access = {kTaggedBase, offset, MaybeHandle<Name>(), type,
+                        machine_type};
+  return access;
+}
+
+
 // static
 FieldAccess AccessBuilder::ForJSObjectProperties() {
   FieldAccess access = {kTaggedBase, JSObject::kPropertiesOffset,
@@ -173,6 +189,15 @@ FieldAccess AccessBuilder::ForFixedArrayLength() {
 }
 
 
+// static
+FieldAccess AccessBuilder::ForFixedTypedArrayBaseExternalPointer() {
+  FieldAccess access = {
+      kTaggedBase, FixedTypedArrayBase::kExternalPointerOffset,
+      MaybeHandle<Name>(), Type::UntaggedPointer(), MachineType::Pointer()};
+  return access;
+}
+
+
 // static
 FieldAccess AccessBuilder::ForDescriptorArrayEnumCache() {
   FieldAccess access = {kTaggedBase, DescriptorArray::kEnumCacheOffset,
@@ -25,6 +25,10 @@ class AccessBuilder final : public AllStatic {
   // Provides access to HeapNumber::value() field.
   static FieldAccess ForHeapNumberValue();
 
+  // Provides access to a single lane of a Simd128Value, e.g. Float32x4.
+  static FieldAccess ForSimd128Lane(int lane, int lane_count, Type* type,
+                                    MachineType machine_type);
+
   // Provides access to JSObject::properties() field.
   static FieldAccess ForJSObjectProperties();
 
@@ -70,6 +74,9 @@ class AccessBuilder final : public AllStatic {
   // Provides access to FixedArray::length() field.
   static FieldAccess ForFixedArrayLength();
 
+  // Provides access to FixedTypedArrayBase::external_pointer() field.
+  static FieldAccess ForFixedTypedArrayBaseExternalPointer();
+
   // Provides access to DescriptorArray::enum_cache() field.
   static FieldAccess ForDescriptorArrayEnumCache();
 
@@ -500,6 +500,9 @@ void InstructionSelector::VisitCheckedStore(Node* node) {
 }
 
 
+void InstructionSelector::VisitAtomicLoad(Node* node) { UNREACHABLE(); }
+
+
 namespace {
 
 void EmitBic(InstructionSelector* selector, Node* node, Node* left,
@@ -165,36 +165,124 @@ int InstructionScheduler::GetTargetInstructionFlags(
 
 
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // Basic latency modeling for arm64 instructions. They have been determined
-  // in an empirical way.
+  // Basic latency modeling for arm64 instructions, based on the Cortex-A57
+  // and Cortex-A72 software optimization guides. Divisions and square roots
+  // take a data-dependent number of cycles; we use the worst case, which
+  // makes the scheduler try to hide them.
   switch (instr->arch_opcode()) {
+    case kArm64Lsl:
+    case kArm64Lsl32:
+    case kArm64Lsr:
+    case kArm64Lsr32:
+    case kArm64Asr:
+    case kArm64Asr32:
+    case kArm64Ror:
+    case kArm64Ror32:
+    case kArm64Ubfx:
+    case kArm64Ubfx32:
+    case kArm64Sbfx32:
+    case kArm64Ubfiz32:
+    case kArm64Bfi:
+      return 2;
+
+    case kArm64Mul32:
+    case kArm64Smull:
+    case kArm64Umull:
+    case kArm64Madd32:
+    case kArm64Msub32:
+    case kArm64Mneg32:
+      return 3;
+
+    case kArm64Mul:
+    case kArm64Madd:
+    case kArm64Msub:
+    case kArm64Mneg:
+      return 5;
+
+    case kArm64Idiv32:
+    case kArm64Udiv32:
+      return 12;
+
+    case kArm64Imod32:
+    case kArm64Umod32:
+      // Division followed by a multiply-subtract.
+      return 15;
+
+    case kArm64Idiv:
+    case kArm64Udiv:
+      return 20;
+
+    case kArm64Imod:
+    case kArm64Umod:
+      return 25;
+
+    case kArm64Float32Abs:
+    case kArm64Float64Abs:
+    case kArm64Float64Neg:
+    case kArm64Float32Cmp:
+    case kArm64Float64Cmp:
+      return 3;
+
+    case kArm64Float32Add:
+    case kArm64Float32Sub:
+    case kArm64Float32Mul:
+    case kArm64Float32Max:
+    case kArm64Float32Min:
+    case kArm64Float64Add:
+    case kArm64Float64Sub:
+    case kArm64Float64Mul:
+    case kArm64Float64Max:
+    case kArm64Float64Min:
+    case kArm64Float32RoundDown:
+    case kArm64Float32RoundTiesEven:
+    case kArm64Float32RoundTruncate:
+    case kArm64Float32RoundUp:
+    case kArm64Float64RoundDown:
+    case kArm64Float64RoundTiesAway:
+    case kArm64Float64RoundTruncate:
+    case kArm64Float64RoundTiesEven:
+    case kArm64Float64RoundUp:
     case kArm64Float32ToFloat64:
     case kArm64Float64ToFloat32:
+      return 5;
+
+    case kArm64Float64ExtractLowWord32:
+    case kArm64Float64ExtractHighWord32:
+    case kArm64Float64MoveU64:
+    case kArm64U64MoveFloat64:
+      // Moves between the general purpose and the FP/SIMD register files.
+      return 5;
+
+    case kArm64Float64InsertLowWord32:
+    case kArm64Float64InsertHighWord32:
+      return 8;
+
     case kArm64Float64ToInt32:
     case kArm64Float64ToUint32:
+    case kArm64Float32ToInt64:
+    case kArm64Float64ToInt64:
+    case kArm64Float32ToUint64:
+    case kArm64Float64ToUint64:
     case kArm64Int32ToFloat64:
+    case kArm64Int64ToFloat32:
+    case kArm64Int64ToFloat64:
     case kArm64Uint32ToFloat64:
-      return 3;
+    case kArm64Uint64ToFloat32:
+    case kArm64Uint64ToFloat64:
+      // Conversions that also cross register files.
+      return 10;
 
-    case kArm64Float64Add:
-    case kArm64Float64Sub:
-      return 2;
+    case kArm64Float32Div:
+      return 11;
 
-    case kArm64Float64Mul:
-      return 3;
+    case kArm64Float32Sqrt:
+      return 17;
 
     case kArm64Float64Div:
-      return 6;
+      return 18;
 
-    case kArm64Lsl:
-    case kArm64Lsl32:
-    case kArm64Lsr:
-    case kArm64Lsr32:
-    case kArm64Asr:
-    case kArm64Asr32:
-    case kArm64Ror:
-    case kArm64Ror32:
-      return 3;
+    case kArm64Float64Sqrt:
+      return 32;
 
     case kCheckedLoadInt8:
     case kCheckedLoadUint8:
@@ -202,16 +290,18 @@ int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
     case kCheckedLoadUint16:
     case kCheckedLoadWord32:
     case kCheckedLoadWord64:
-    case kCheckedLoadFloat32:
-    case kCheckedLoadFloat64:
-    case kArm64LdrS:
-    case kArm64LdrD:
     case kArm64Ldrb:
     case kArm64Ldrsb:
     case kArm64Ldrh:
     case kArm64Ldrsh:
     case kArm64LdrW:
     case kArm64Ldr:
+      return 4;
+
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+    case kArm64LdrS:
+    case kArm64LdrD:
       return 5;
 
     default:
@@ -545,6 +545,9 @@ void InstructionSelector::VisitCheckedStore(Node* node) {
 }
 
 
+void InstructionSelector::VisitAtomicLoad(Node* node) { UNREACHABLE(); }
+
+
 template <typename Matcher>
 static void VisitLogical(InstructionSelector* selector, Node* node, Matcher* m,
                          ArchOpcode opcode, bool left_can_cover,
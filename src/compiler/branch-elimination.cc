@@ -5,6 +5,7 @@
 #include "src/compiler/branch-elimination.h"
 
 #include "src/compiler/js-graph.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
 
@@ -234,6 +235,50 @@ BranchElimination::ControlPathConditions::AddCondition(Zone* zone,
 }
 
 
+namespace {
+
+// Matches a comparison of some value with a heap constant, i.e. the shape of
+// a map check (before or after simplified lowering).
+bool MatchHeapConstantCompare(Node* node, Node** value,
+                              Handle<HeapObject>* constant) {
+  switch (node->opcode()) {
+    case IrOpcode::kReferenceEqual:
+    case IrOpcode::kWord32Equal:
+    case IrOpcode::kWord64Equal:
+      break;
+    default:
+      return false;
+  }
+  for (int i = 0; i < 2; ++i) {
+    HeapObjectMatcher m(node->InputAt(i));
+    if (m.HasValue()) {
+      *value = node->InputAt(1 - i);
+      *constant = m.Value();
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// Returns true if {condition} is known to be false on all paths where {other}
+// is true, because both compare the same value against different heap
+// constants. This is what allows a map check to be folded if another map check
+// on the same map value already succeeded.
+bool ExcludedBy(Node* condition, Node* other) {
+  Node* value;
+  Node* other_value;
+  Handle<HeapObject> constant;
+  Handle<HeapObject> other_constant;
+  return condition->opcode() == other->opcode() &&
+         MatchHeapConstantCompare(condition, &value, &constant) &&
+         MatchHeapConstantCompare(other, &other_value, &other_constant) &&
+         value == other_value && !constant.is_identical_to(other_constant);
+}
+
+}  // namespace
+
+
 Maybe<bool> BranchElimination::ControlPathConditions::LookupCondition(
     Node* condition) const {
   for (BranchCondition* current = head_; current != nullptr;
@@ -241,6 +286,9 @@ Maybe<bool> BranchElimination::ControlPathConditions::LookupCondition(
     if (current->condition == condition) {
       return Just<bool>(current->is_true);
     }
+    if (current->is_true && ExcludedBy(condition, current->condition)) {
+      return Just<bool>(false);
+    }
   }
   return Nothing<bool>();
 }
@@ -143,6 +143,10 @@ class BytecodeGraphBuilder {
   void BuildLoadGlobal(const interpreter::BytecodeArrayIterator& iterator,
                        TypeofMode typeof_mode);
   void BuildStoreGlobal(const interpreter::BytecodeArrayIterator& iterator);
+  void BuildLdaLookupSlot(TypeofMode typeof_mode,
+                          const interpreter::BytecodeArrayIterator& iterator);
+  void BuildStaLookupSlot(LanguageMode language_mode,
+                          const interpreter::BytecodeArrayIterator& iterator);
   void BuildNamedLoad(const interpreter::BytecodeArrayIterator& iterator);
   void BuildKeyedLoad(const interpreter::BytecodeArrayIterator& iterator);
   void BuildNamedStore(const interpreter::BytecodeArrayIterator& iterator);
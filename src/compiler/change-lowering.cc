@@ -9,6 +9,7 @@
 #include "src/compiler/js-graph.h"
 #include "src/compiler/linkage.h"
 #include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/operator-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -496,6 +497,7 @@ Reduction ChangeLowering::StoreField(Node* node) {
   WriteBarrierKind kind = ComputeWriteBarrierKind(
       access.base_is_tagged, access.machine_type.representation(),
       access.offset, access.type, type);
+  if (IsFreshNewSpaceObject(node)) kind = kNoWriteBarrier;
   Node* offset = jsgraph()->IntPtrConstant(access.offset - access.tag());
   node->InsertInput(graph()->zone(), 1, offset);
   NodeProperties::ChangeOp(node,
@@ -540,20 +542,217 @@ Reduction ChangeLowering::LoadElement(Node* node) {
 Reduction ChangeLowering::StoreElement(Node* node) {
   const ElementAccess& access = ElementAccessOf(node->op());
   Type* type = NodeProperties::GetType(node->InputAt(2));
+  WriteBarrierKind kind = ComputeWriteBarrierKind(
+      access.base_is_tagged, access.machine_type.representation(),
+      access.type, type);
+  if (IsFreshNewSpaceObject(node)) kind = kNoWriteBarrier;
   node->ReplaceInput(1, ComputeIndex(access, node->InputAt(1)));
   NodeProperties::ChangeOp(
       node, machine()->Store(StoreRepresentation(
-                access.machine_type.representation(),
-                ComputeWriteBarrierKind(access.base_is_tagged,
-                                        access.machine_type.representation(),
-                                        access.type, type))));
+                access.machine_type.representation(), kind)));
   return Changed(node);
 }
 
 
+bool ChangeLowering::IsNewSpaceAllocation(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kAllocate:
+      return OpParameter<PretenureFlag>(node->op()) == NOT_TENURED;
+    case IrOpcode::kCall: {
+      // Allocations in new space are lowered to calls to the
+      // AllocateInNewSpace stub, see ChangeLowering::Allocate below.
+      HeapObjectMatcher m(node->InputAt(0));
+      return m.HasValue() &&
+             m.Value().is_identical_to(
+                 CodeFactory::AllocateInNewSpace(isolate()).code());
+    }
+    default:
+      return false;
+  }
+}
+
+
+bool ChangeLowering::IsFreshNewSpaceObject(Node* store) {
+  Node* object = NodeProperties::GetValueInput(store, 0);
+  if (object->opcode() == IrOpcode::kFinishRegion) {
+    object = NodeProperties::GetValueInput(object, 0);
+  }
+  // Objects that were folded into a dominating allocation live in the same
+  // chunk as that allocation, see ChangeLowering::FoldAllocation below.
+  if (object->opcode() == IrOpcode::kGuard) {
+    Node* const address = NodeProperties::GetValueInput(object, 0);
+    if (address->op() != machine()->IntAdd()) return false;
+    object = NodeProperties::GetValueInput(address, 0);
+    if (object->opcode() == IrOpcode::kFinishRegion) {
+      object = NodeProperties::GetValueInput(object, 0);
+    }
+  }
+  if (!IsNewSpaceAllocation(object)) return false;
+  // Make sure that nothing between the allocation and the {store} can trigger
+  // a GC, which might promote the {object}. That includes floating HeapNumber
+  // allocations, which end up right in front of the nodes that use them.
+  if (HasFloatingAllocationInput(store, object)) return false;
+  for (Node* effect = NodeProperties::GetEffectInput(store); effect != object;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    if (HasFloatingAllocationInput(effect, object)) return false;
+    switch (effect->opcode()) {
+      case IrOpcode::kBeginRegion:
+      case IrOpcode::kFinishRegion:
+      case IrOpcode::kLoad:
+      case IrOpcode::kLoadField:
+      case IrOpcode::kLoadElement:
+      case IrOpcode::kStore:
+      case IrOpcode::kStoreField:
+      case IrOpcode::kStoreElement:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+
+bool ChangeLowering::HasFloatingAllocationInput(Node* node,
+                                                Node* allocation) {
+  // Give up (conservatively) on big value graphs.
+  static const size_t kMaxVisitedNodes = 32;
+  ZoneVector<Node*> stack(graph()->zone());
+  size_t visited = 0;
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    stack.push_back(NodeProperties::GetValueInput(node, i));
+  }
+  while (!stack.empty()) {
+    Node* const input = stack.back();
+    stack.pop_back();
+    if (++visited > kMaxVisitedNodes) return true;
+    if (input == allocation) continue;
+    if (input->opcode() == IrOpcode::kFinishRegion) {
+      if (NodeProperties::GetValueInput(input, 0) == allocation) continue;
+      return true;
+    }
+    // Nodes with effects are fixed on an effect chain, and the callers check
+    // that chain. Pure nodes are placed right in front of their uses, and so
+    // are their inputs.
+    if (input->op()->EffectOutputCount() > 0) continue;
+    for (int i = 0; i < input->op()->ValueInputCount(); ++i) {
+      stack.push_back(NodeProperties::GetValueInput(input, i));
+    }
+  }
+  return false;
+}
+
+
+Reduction ChangeLowering::FoldAllocation(Node* node) {
+  NumberMatcher m(NodeProperties::GetValueInput(node, 0));
+  if (!m.IsInRange(0, Page::kMaxRegularHeapObjectSize)) return NoChange();
+  int const size = static_cast<int>(m.Value());
+  DCHECK_EQ(size, m.Value());
+  DCHECK(IsAligned(size, kPointerSize));
+  Node* const effect = NodeProperties::GetEffectInput(node);
+  Node* const control = NodeProperties::GetControlInput(node);
+
+  // Walk up the effect chain to the dominating allocation. Nothing on the
+  // way must be able to trigger a GC, and the dominating allocation must be
+  // completely initialized, i.e. its region must have been finished.
+  Node* region = nullptr;
+  Node* dominator = effect;
+  ZoneVector<Node*> between(graph()->zone());
+  for (; dominator->opcode() != IrOpcode::kCall;
+       dominator = NodeProperties::GetEffectInput(dominator)) {
+    between.push_back(dominator);
+    switch (dominator->opcode()) {
+      case IrOpcode::kFinishRegion:
+        region = dominator;
+        break;
+      case IrOpcode::kBeginRegion:
+      case IrOpcode::kLoad:
+      case IrOpcode::kLoadField:
+      case IrOpcode::kLoadElement:
+      case IrOpcode::kStore:
+      case IrOpcode::kStoreField:
+      case IrOpcode::kStoreElement:
+        break;
+      default:
+        return NoChange();
+    }
+  }
+  if (!IsNewSpaceAllocation(dominator)) return NoChange();
+  if (region == nullptr || region->InputAt(0) != dominator) return NoChange();
+  // Floating HeapNumber allocations would be placed right in front of the
+  // nodes that use them, so there must be none between the two allocations.
+  for (Node* const other : between) {
+    if (HasFloatingAllocationInput(other, dominator)) return NoChange();
+  }
+  // Don't fold across control flow, as we'd waste the space for the {node}
+  // whenever the path to the {node} is not taken.
+  if (NodeProperties::GetControlInput(dominator) != control) return NoChange();
+  NumberMatcher mdominator(dominator->InputAt(1));
+  if (!mdominator.HasValue()) return NoChange();
+  int const dominator_size = static_cast<int>(mdominator.Value());
+  if (size > Page::kMaxRegularHeapObjectSize - dominator_size) {
+    return NoChange();
+  }
+
+  // Grow the dominating allocation to also cover the {node}. The space for
+  // the {node} is turned into a filler right away, so that the heap stays
+  // iterable even if a GC happens before the {node} is initialized.
+  dominator->ReplaceInput(1, jsgraph()->Constant(dominator_size + size));
+  InsertFiller(dominator, dominator_size, size);
+
+  // The {node} now lives at a fixed offset from the dominating allocation.
+  // The Guard makes sure that the inner pointer is treated as tagged value.
+  Node* value =
+      graph()->NewNode(machine()->IntAdd(), region,
+                       jsgraph()->IntPtrConstant(dominator_size));
+  value = graph()->NewNode(common()->Guard(Type::Any()), value, control);
+  for (Edge edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+  }
+  return Replace(value);
+}
+
+
+void ChangeLowering::InsertFiller(Node* allocation, int offset, int size) {
+  Handle<Map> map;
+  if (size == kPointerSize) {
+    map = isolate()->factory()->one_pointer_filler_map();
+  } else if (size == 2 * kPointerSize) {
+    map = isolate()->factory()->two_pointer_filler_map();
+  } else {
+    map = isolate()->factory()->free_space_map();
+  }
+  Node* const control = NodeProperties::GetControlInput(allocation);
+  const Operator* const op = machine()->Store(
+      StoreRepresentation(MachineRepresentation::kTagged, kNoWriteBarrier));
+  Node* const first = graph()->NewNode(
+      op, allocation,
+      jsgraph()->IntPtrConstant(offset + HeapObject::kMapOffset -
+                                kHeapObjectTag),
+      jsgraph()->HeapConstant(map), allocation, control);
+  Node* last = first;
+  if (size > 2 * kPointerSize) {
+    last = graph()->NewNode(
+        op, allocation,
+        jsgraph()->IntPtrConstant(offset + FreeSpace::kSizeOffset -
+                                  kHeapObjectTag),
+        jsgraph()->SmiConstant(size), first, control);
+  }
+  for (Edge edge : allocation->use_edges()) {
+    if (edge.from() != first && NodeProperties::IsEffectEdge(edge)) {
+      edge.UpdateTo(last);
+    }
+  }
+}
+
+
 Reduction ChangeLowering::Allocate(Node* node) {
   PretenureFlag pretenure = OpParameter<PretenureFlag>(node->op());
   if (pretenure == NOT_TENURED) {
+    if (FLAG_turbo_allocation_folding) {
+      Reduction const reduction = FoldAllocation(node);
+      if (reduction.Changed()) return reduction;
+    }
     Callable callable = CodeFactory::AllocateInNewSpace(isolate());
     Node* target = jsgraph()->HeapConstant(callable.code());
     CallDescriptor* descriptor = Linkage::GetStubCallDescriptor(
@@ -56,6 +56,26 @@ class ChangeLowering final : public Reducer {
   Reduction StoreElement(Node* node);
   Reduction Allocate(Node* node);
 
+  // Folds a constant size allocation in new space into a dominating one on
+  // the same effect chain, so that both objects are allocated with a single
+  // bump of the allocation top. The folded object is addressed relative to
+  // the dominating allocation.
+  Reduction FoldAllocation(Node* node);
+  void InsertFiller(Node* allocation, int offset, int size);
+
+  // Stores into an object that was just allocated in new space don't need a
+  // write barrier, since the GC always scans new space completely. This is
+  // only true as long as no GC can happen between the allocation and the
+  // {store}, i.e. as long as the object is still in new space.
+  bool IsFreshNewSpaceObject(Node* store);
+  bool IsNewSpaceAllocation(Node* node);
+  // The HeapNumber boxes allocated by AllocateHeapNumberWithValue are not on
+  // the effect chain, and the scheduler places them right in front of the
+  // nodes that use them. Returns true if such an allocation (or any other
+  // region except the one of {allocation}) may flow into a value input of
+  // {node}, in which case a GC may happen right before {node}.
+  bool HasFloatingAllocationInput(Node* node, Node* allocation);
+
   Node* ComputeIndex(const ElementAccess& access, Node* const key);
   Graph* graph() const;
   Isolate* isolate() const;
@@ -460,7 +460,7 @@ void CodeGenerator::RecordCallPosition(Instruction* instr) {
     // Make sure all the values live in stack slots or they are immediates.
     // (The values should not live in register because registers are clobbered
     // by calls.)
-    for (size_t i = 0; i < descriptor->GetSize(); i++) {
+    for (size_t i = 0; i < descriptor->GetTotalSize(); i++) {
       InstructionOperand* op = instr->InputAt(frame_state_offset + 1 + i);
       CHECK(op->IsStackSlot() || op->IsDoubleStackSlot() || op->IsImmediate());
     }
@@ -491,17 +491,12 @@ FrameStateDescriptor* CodeGenerator::GetFrameStateDescriptor(
 
 namespace {
 
-struct OperandAndType {
-  InstructionOperand* const operand;
-  MachineType const type;
-};
-
-
-OperandAndType TypedOperandForFrameState(FrameStateDescriptor* descriptor,
-                                         Instruction* instr,
-                                         size_t frame_state_offset,
-                                         size_t index,
-                                         OutputFrameStateCombine combine) {
+// Returns the output of {instr} that is stored into the frame state slot
+// {index} according to {combine}, or nullptr if the slot keeps the value
+// recorded in the frame state.
+InstructionOperand* OutputForFrameStateSlot(FrameStateDescriptor* descriptor,
+                                            Instruction* instr, size_t index,
+                                            OutputFrameStateCombine combine) {
   DCHECK(index < descriptor->GetSize(combine));
   switch (combine.kind()) {
     case OutputFrameStateCombine::kPushOutput: {
@@ -510,8 +505,7 @@ OperandAndType TypedOperandForFrameState(FrameStateDescriptor* descriptor,
           descriptor->GetSize(OutputFrameStateCombine::Ignore());
       // If the index is past the existing stack items, return the output.
       if (index >= size_without_output) {
-        return {instr->OutputAt(index - size_without_output),
-                MachineType::AnyTagged()};
+        return instr->OutputAt(index - size_without_output);
       }
       break;
     }
@@ -520,27 +514,54 @@ OperandAndType TypedOperandForFrameState(FrameStateDescriptor* descriptor,
           descriptor->GetSize(combine) - 1 - combine.GetOffsetToPokeAt();
       if (index >= index_from_top &&
           index < index_from_top + instr->OutputCount()) {
-        return {instr->OutputAt(index - index_from_top),
-                MachineType::AnyTagged()};
+        return instr->OutputAt(index - index_from_top);
       }
       break;
   }
-  return {instr->InputAt(frame_state_offset + index),
-          descriptor->GetType(index)};
+  return nullptr;
 }
 
 }  // namespace
 
 
+void CodeGenerator::TranslateStateValueDescriptor(
+    StateValueDescriptor* desc, Translation* translation, Instruction* instr,
+    size_t* operand_index, ZoneVector<size_t>* object_ids) {
+  if (desc->IsPlain()) {
+    AddTranslationForOperand(translation, instr,
+                             instr->InputAt((*operand_index)++), desc->type());
+    return;
+  }
+  DCHECK(desc->IsNested());
+  // The deoptimizer numbers captured objects (and their duplicates) in the
+  // order in which they appear in the translation.
+  auto it = std::find(object_ids->begin(), object_ids->end(), desc->id());
+  if (it != object_ids->end()) {
+    // The object has already been described, so just refer to it and skip
+    // the operands for its fields.
+    translation->DuplicateObject(static_cast<int>(it - object_ids->begin()));
+    object_ids->push_back(desc->id());
+    *operand_index += desc->GetOperandCount();
+    return;
+  }
+  object_ids->push_back(desc->id());
+  translation->BeginCapturedObject(static_cast<int>(desc->size()));
+  for (StateValueDescriptor& field : desc->fields()) {
+    TranslateStateValueDescriptor(&field, translation, instr, operand_index,
+                                  object_ids);
+  }
+}
+
+
 void CodeGenerator::BuildTranslationForFrameStateDescriptor(
     FrameStateDescriptor* descriptor, Instruction* instr,
     Translation* translation, size_t frame_state_offset,
-    OutputFrameStateCombine state_combine) {
+    OutputFrameStateCombine state_combine, ZoneVector<size_t>* object_ids) {
   // Outer-most state must be added to translation first.
   if (descriptor->outer_state() != nullptr) {
-    BuildTranslationForFrameStateDescriptor(descriptor->outer_state(), instr,
-                                            translation, frame_state_offset,
-                                            OutputFrameStateCombine::Ignore());
+    BuildTranslationForFrameStateDescriptor(
+        descriptor->outer_state(), instr, translation, frame_state_offset,
+        OutputFrameStateCombine::Ignore(), object_ids);
   }
   frame_state_offset += descriptor->outer_state()->GetTotalSize();
 
@@ -575,10 +596,21 @@ void CodeGenerator::BuildTranslationForFrameStateDescriptor(
       break;
   }
 
+  StateValueDescriptor* values = descriptor->GetStateValueDescriptor();
+  size_t operand_index = frame_state_offset;
   for (size_t i = 0; i < descriptor->GetSize(state_combine); i++) {
-    OperandAndType op = TypedOperandForFrameState(
-        descriptor, instr, frame_state_offset, i, state_combine);
-    AddTranslationForOperand(translation, instr, op.operand, op.type);
+    if (InstructionOperand* output =
+            OutputForFrameStateSlot(descriptor, instr, i, state_combine)) {
+      AddTranslationForOperand(translation, instr, output,
+                               MachineType::AnyTagged());
+      // Skip the operands of the value that the output replaces, if any.
+      if (i < values->size()) {
+        operand_index += values->fields()[i].GetOperandCount();
+      }
+    } else {
+      TranslateStateValueDescriptor(&values->fields()[i], translation, instr,
+                                    &operand_index, object_ids);
+    }
   }
 }
 
@@ -593,8 +625,10 @@ int CodeGenerator::BuildTranslation(Instruction* instr, int pc_offset,
   Translation translation(
       &translations_, static_cast<int>(descriptor->GetFrameCount()),
       static_cast<int>(descriptor->GetJSFrameCount()), zone());
+  ZoneVector<size_t> object_ids(zone());
   BuildTranslationForFrameStateDescriptor(descriptor, instr, &translation,
-                                          frame_state_offset, state_combine);
+                                          frame_state_offset, state_combine,
+                                          &object_ids);
 
   int deoptimization_id = static_cast<int>(deoptimization_states_.size());
 
@@ -138,7 +138,11 @@ class CodeGenerator final : public GapResolver::Assembler {
   void BuildTranslationForFrameStateDescriptor(
       FrameStateDescriptor* descriptor, Instruction* instr,
       Translation* translation, size_t frame_access_state_offset,
-      OutputFrameStateCombine state_combine);
+      OutputFrameStateCombine state_combine, ZoneVector<size_t>* object_ids);
+  void TranslateStateValueDescriptor(StateValueDescriptor* desc,
+                                     Translation* translation,
+                                     Instruction* instr, size_t* operand_index,
+                                     ZoneVector<size_t>* object_ids);
   void AddTranslationForOperand(Translation* translation, Instruction* instr,
                                 InstructionOperand* op, MachineType type);
   void AddNopForSmiCodeInlining();
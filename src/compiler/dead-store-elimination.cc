@@ -0,0 +1,108 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/dead-store-elimination.h"
+
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+namespace {
+
+// Returns true if {node} has exactly one effect use.
+bool HasSingleEffectUse(Node* node) {
+  int effect_uses = 0;
+  for (Edge edge : node->use_edges()) {
+    if (NodeProperties::IsEffectEdge(edge) && ++effect_uses > 1) return false;
+  }
+  return effect_uses == 1;
+}
+
+
+// Returns true if accesses {lhs} and {rhs} may touch the same memory, if the
+// objects are the same (or alias).
+bool MayOverlap(FieldAccess const& lhs, FieldAccess const& rhs) {
+  if (lhs.base_is_tagged != rhs.base_is_tagged) return false;
+  int const lhs_end =
+      lhs.offset + (1 << ElementSizeLog2Of(lhs.machine_type.representation()));
+  int const rhs_end =
+      rhs.offset + (1 << ElementSizeLog2Of(rhs.machine_type.representation()));
+  return lhs.offset < rhs_end && rhs.offset < lhs_end;
+}
+
+}  // namespace
+
+
+DeadStoreElimination::~DeadStoreElimination() {}
+
+
+Reduction DeadStoreElimination::Reduce(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kStoreField:
+      return ReduceStoreField(node);
+    default:
+      break;
+  }
+  return NoChange();
+}
+
+
+Reduction DeadStoreElimination::ReduceStoreField(Node* node) {
+  DCHECK_EQ(IrOpcode::kStoreField, node->opcode());
+  FieldAccess const access = FieldAccessOf(node->op());
+  Node* object = NodeProperties::GetValueInput(node, 0);
+  for (Node* effect = NodeProperties::GetEffectInput(node);;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    // Anything that is observed by some other node (i.e. a deoptimization
+    // point or another path in the graph) ends the search.
+    if (!HasSingleEffectUse(effect)) return NoChange();
+    switch (effect->opcode()) {
+      case IrOpcode::kStoreField: {
+        FieldAccess const effect_access = FieldAccessOf(effect->op());
+        if (access == effect_access &&
+            object == NodeProperties::GetValueInput(effect, 0)) {
+          // The {effect} store is overwritten by {node} before anyone can
+          // observe it, so just remove it from the effect chain.
+          Replace(effect, NodeProperties::GetEffectInput(effect));
+          return NoChange();
+        }
+        // Other stores don't observe the field.
+        break;
+      }
+      case IrOpcode::kLoadField: {
+        // The load might observe the field through an alias of {object}.
+        if (MayOverlap(access, FieldAccessOf(effect->op()))) {
+          return NoChange();
+        }
+        break;
+      }
+      case IrOpcode::kLoadBuffer:
+      case IrOpcode::kLoadElement:
+      case IrOpcode::kStoreBuffer:
+      case IrOpcode::kStoreElement: {
+        // These can never observe fields.
+        break;
+      }
+      case IrOpcode::kBeginRegion:
+      case IrOpcode::kFinishRegion: {
+        // Never remove the initializing stores of a fresh allocation. The
+        // HeapNumber boxes introduced by ChangeLowering are not on the effect
+        // chain and may end up between the allocation and {node}, so a GC
+        // could observe the uninitialized field.
+        return NoChange();
+      }
+      default:
+        return NoChange();
+    }
+  }
+  UNREACHABLE();
+  return NoChange();
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,35 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_DEAD_STORE_ELIMINATION_H_
+#define V8_COMPILER_DEAD_STORE_ELIMINATION_H_
+
+#include "src/compiler/graph-reducer.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Removes field stores that are overwritten by a later store to the same
+// field of the same object, before anything can observe the first store.
+// Everything on the effect chain in between must be a store or a load of
+// some other field, and must not be used by anything else (i.e. there must
+// be no deoptimization point in between, since the deoptimizer would
+// observe the stored value).
+class DeadStoreElimination final : public AdvancedReducer {
+ public:
+  explicit DeadStoreElimination(Editor* editor) : AdvancedReducer(editor) {}
+  ~DeadStoreElimination() final;
+
+  Reduction Reduce(Node* node) final;
+
+ private:
+  Reduction ReduceStoreField(Node* node);
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_DEAD_STORE_ELIMINATION_H_
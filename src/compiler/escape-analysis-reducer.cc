@@ -36,19 +36,29 @@ Reduction EscapeAnalysisReducer::Reduce(Node* node) {
       return ReduceReferenceEqual(node);
     case IrOpcode::kObjectIsSmi:
       return ReduceObjectIsSmi(node);
-    case IrOpcode::kStateValues:
-    case IrOpcode::kFrameState:
-      return ReplaceWithDeoptDummy(node);
     default:
+      if (node->op()->EffectInputCount() > 0) {
+        return ReduceFrameStateUses(node);
+      }
       break;
   }
   return NoChange();
 }
 
 
+Node* EscapeAnalysisReducer::ResolveReplacement(Node* node) {
+  if (Node* rep = escape_analysis()->GetReplacement(node)) return rep;
+  return node;
+}
+
+
 Reduction EscapeAnalysisReducer::ReduceLoad(Node* node) {
   DCHECK(node->opcode() == IrOpcode::kLoadField ||
          node->opcode() == IrOpcode::kLoadElement);
+  // Only trust the recorded value if the object does not escape, otherwise
+  // it might have been changed behind our back.
+  Node* from = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
+  if (!escape_analysis()->IsVirtual(from)) return NoChange();
   if (Node* rep = escape_analysis()->GetReplacement(node)) {
     if (FLAG_trace_turbo_escape) {
       PrintF("Replaced #%d (%s) with #%d (%s)\n", node->id(),
@@ -64,7 +74,8 @@ Reduction EscapeAnalysisReducer::ReduceLoad(Node* node) {
 Reduction EscapeAnalysisReducer::ReduceStore(Node* node) {
   DCHECK(node->opcode() == IrOpcode::kStoreField ||
          node->opcode() == IrOpcode::kStoreElement);
-  if (escape_analysis()->IsVirtual(NodeProperties::GetValueInput(node, 0))) {
+  Node* to = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
+  if (escape_analysis()->IsVirtual(to)) {
     if (FLAG_trace_turbo_escape) {
       PrintF("Removed #%d (%s) from effect chain\n", node->id(),
              node->op()->mnemonic());
@@ -112,17 +123,10 @@ Reduction EscapeAnalysisReducer::ReduceFinishRegion(Node* node) {
 
 Reduction EscapeAnalysisReducer::ReduceReferenceEqual(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kReferenceEqual);
-  Node* left = NodeProperties::GetValueInput(node, 0);
-  Node* right = NodeProperties::GetValueInput(node, 1);
+  Node* left = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
+  Node* right = ResolveReplacement(NodeProperties::GetValueInput(node, 1));
   if (escape_analysis()->IsVirtual(left)) {
     if (escape_analysis()->IsVirtual(right)) {
-      if (Node* rep = escape_analysis()->GetReplacement(left)) {
-        left = rep;
-      }
-      if (Node* rep = escape_analysis()->GetReplacement(right)) {
-        right = rep;
-      }
-      // TODO(sigurds): What to do if either is a PHI?
       if (left == right) {
         ReplaceWithValue(node, jsgraph()->TrueConstant());
         if (FLAG_trace_turbo_escape) {
@@ -143,6 +147,7 @@ Reduction EscapeAnalysisReducer::ReduceReferenceEqual(Node* node) {
     if (FLAG_trace_turbo_escape) {
       PrintF("Replaced ref eq #%d with false\n", node->id());
     }
+    return Replace(node);
   }
   return NoChange();
 }
@@ -150,7 +155,7 @@ Reduction EscapeAnalysisReducer::ReduceReferenceEqual(Node* node) {
 
 Reduction EscapeAnalysisReducer::ReduceObjectIsSmi(Node* node) {
   DCHECK_EQ(node->opcode(), IrOpcode::kObjectIsSmi);
-  Node* input = NodeProperties::GetValueInput(node, 0);
+  Node* input = ResolveReplacement(NodeProperties::GetValueInput(node, 0));
   if (escape_analysis()->IsVirtual(input)) {
     ReplaceWithValue(node, jsgraph()->FalseConstant());
     if (FLAG_trace_turbo_escape) {
@@ -162,28 +167,52 @@ Reduction EscapeAnalysisReducer::ReduceObjectIsSmi(Node* node) {
 }
 
 
-// TODO(sigurds): This is a temporary solution until escape analysis
-// supports deoptimization.
-Reduction EscapeAnalysisReducer::ReplaceWithDeoptDummy(Node* node) {
-  DCHECK(node->opcode() == IrOpcode::kStateValues ||
-         node->opcode() == IrOpcode::kFrameState);
-  Reduction r = NoChange();
-  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
-    Node* input = NodeProperties::GetValueInput(node, i);
-    if (input->opcode() == IrOpcode::kFinishRegion ||
-        input->opcode() == IrOpcode::kAllocate ||
-        input->opcode() == IrOpcode::kPhi) {
-      if (escape_analysis()->IsVirtual(input)) {
-        NodeProperties::ReplaceValueInput(node, jsgraph()->UndefinedConstant(),
-                                          i);
-        if (FLAG_trace_turbo_escape) {
-          PrintF("Replaced state value (#%d) input with dummy\n", node->id());
-        }
-        r = Changed(node);
+Reduction EscapeAnalysisReducer::ReduceFrameStateUses(Node* node) {
+  DCHECK_GE(node->op()->EffectInputCount(), 1);
+  bool changed = false;
+  for (int i = 0; i < node->InputCount(); ++i) {
+    Node* input = node->InputAt(i);
+    if (input->opcode() == IrOpcode::kFrameState) {
+      if (Node* ret = ReduceDeoptState(input, node, false)) {
+        node->ReplaceInput(i, ret);
+        changed = true;
       }
     }
   }
-  return r;
+  return changed ? Changed(node) : NoChange();
+}
+
+
+// Replaces virtual objects in the frame state or state values {node} by
+// object states describing them at {effect}. Since frame states are shared
+// between effectful nodes, {node} is cloned unless {effect} is its only
+// (transitive) user. Returns the clone, or nullptr if {node} was not cloned.
+Node* EscapeAnalysisReducer::ReduceDeoptState(Node* node, Node* effect,
+                                              bool multiple_users) {
+  DCHECK(node->opcode() == IrOpcode::kFrameState ||
+         node->opcode() == IrOpcode::kStateValues);
+  multiple_users = multiple_users || node->UseCount() > 1;
+  Node* clone = nullptr;
+  for (int i = 0; i < node->InputCount(); ++i) {
+    Node* input = node->InputAt(i);
+    Node* ret = nullptr;
+    if (input->opcode() == IrOpcode::kFrameState ||
+        input->opcode() == IrOpcode::kStateValues) {
+      ret = ReduceDeoptState(input, effect, multiple_users);
+    } else {
+      ret = escape_analysis()->GetOrCreateObjectState(effect, input);
+    }
+    if (ret == nullptr) continue;
+    if (multiple_users && clone == nullptr) {
+      node = clone = jsgraph()->graph()->CloneNode(node);
+    }
+    node->ReplaceInput(i, ret);
+    if (FLAG_trace_turbo_escape) {
+      PrintF("Replaced input %d of #%d (%s) with #%d (%s)\n", i, node->id(),
+             node->op()->mnemonic(), ret->id(), ret->op()->mnemonic());
+    }
+  }
+  return clone;
 }
 
 
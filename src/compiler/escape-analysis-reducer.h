@@ -30,8 +30,10 @@ class EscapeAnalysisReducer final : public AdvancedReducer {
   Reduction ReduceFinishRegion(Node* node);
   Reduction ReduceReferenceEqual(Node* node);
   Reduction ReduceObjectIsSmi(Node* node);
+  Reduction ReduceFrameStateUses(Node* node);
+  Node* ReduceDeoptState(Node* node, Node* effect, bool multiple_users);
 
-  Reduction ReplaceWithDeoptDummy(Node* node);
+  Node* ResolveReplacement(Node* node);
 
   JSGraph* jsgraph() const { return jsgraph_; }
   EscapeAnalysis* escape_analysis() const { return escape_analysis_; }
@@ -29,16 +29,25 @@ class VirtualObject : public ZoneObject {
  public:
   enum Status { kUntracked = 0, kTracked = 1 };
   VirtualObject(NodeId id, Zone* zone)
-      : id_(id), status_(kUntracked), fields_(zone), phi_(zone) {}
+      : id_(id),
+        status_(kUntracked),
+        fields_(zone),
+        phi_(zone),
+        object_state_(nullptr) {}
 
   VirtualObject(const VirtualObject& other)
       : id_(other.id_),
         status_(other.status_),
         fields_(other.fields_),
-        phi_(other.phi_) {}
+        phi_(other.phi_),
+        object_state_(nullptr) {}
 
   VirtualObject(NodeId id, Zone* zone, size_t field_number)
-      : id_(id), status_(kTracked), fields_(zone), phi_(zone) {
+      : id_(id),
+        status_(kTracked),
+        fields_(zone),
+        phi_(zone),
+        object_state_(nullptr) {
     fields_.resize(field_number);
     phi_.resize(field_number, false);
   }
@@ -96,11 +105,15 @@ class VirtualObject : public ZoneObject {
   NodeId id() { return id_; }
   void id(NodeId id) { id_ = id; }
 
+  Node* GetObjectState() const { return object_state_; }
+  void SetObjectState(Node* node) { object_state_ = node; }
+
  private:
   NodeId id_;
   Status status_;
   ZoneVector<Node*> fields_;
   ZoneVector<bool> phi_;
+  Node* object_state_;
 };
 
 
@@ -382,14 +395,18 @@ bool VirtualState::MergeFrom(MergeCache* cache, Zone* zone, Graph* graph,
           }
         } else {
           GetFields(cache->objects(), cache->fields(), i);
-          if (cache->fields().size() == cache->objects().size()) {
+          // A phi can only be built if every predecessor (including loop
+          // back edges) has provided a value for the field.
+          int value_input_count = static_cast<int>(cache->fields().size());
+          if (cache->fields().size() == cache->objects().size() &&
+              value_input_count == control->op()->ControlInputCount()) {
             Node* rep = mergeObject->GetField(i);
             if (!rep || !mergeObject->IsCreatedPhi(i)) {
               cache->fields().push_back(control);
-              Node* phi =
-                  graph->NewNode(common->Phi(MachineRepresentation::kTagged, 2),
-                                 static_cast<int>(cache->fields().size()),
-                                 &cache->fields().front());
+              Node* phi = graph->NewNode(
+                  common->Phi(MachineRepresentation::kTagged,
+                              value_input_count),
+                  value_input_count + 1, &cache->fields().front());
               mergeObject->SetField(i, phi, true);
               if (FLAG_trace_turbo_escape) {
                 PrintF("    Creating Phi #%d as merge of", phi->id());
@@ -543,6 +560,17 @@ void EscapeStatusAnalysis::Process(Node* node) {
           RevisitInputs(rep);
           RevisitUses(rep);
         }
+      } else {
+        // The value of the load is unknown, so the object has to exist.
+        Node* from = NodeProperties::GetValueInput(node, 0);
+        if (IsAllocation(from) && SetEscaped(from)) {
+          RevisitInputs(from);
+          RevisitUses(from);
+          if (FLAG_trace_turbo_escape) {
+            PrintF("Setting #%d (%s) to escaped because of unknown load #%d\n",
+                   from->id(), from->op()->mnemonic(), node->id());
+          }
+        }
       }
       break;
     }
@@ -653,19 +681,17 @@ bool EscapeStatusAnalysis::CheckUsesForEscape(Node* uses, Node* rep,
         break;
       case IrOpcode::kObjectIsSmi:
         if (!IsAllocation(rep) && SetEscaped(rep)) {
-          PrintF("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
-                 rep->id(), rep->op()->mnemonic(), use->id(),
-                 use->op()->mnemonic());
+          if (FLAG_trace_turbo_escape) {
+            PrintF("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
+                   rep->id(), rep->op()->mnemonic(), use->id(),
+                   use->op()->mnemonic());
+          }
           return true;
         }
         break;
       default:
-        if (use->op()->EffectInputCount() == 0 &&
-            uses->op()->EffectInputCount() > 0) {
-          PrintF("Encountered unaccounted use by #%d (%s)\n", use->id(),
-                 use->op()->mnemonic());
-          UNREACHABLE();
-        }
+        // Any other use (including pure uses that are not accounted for
+        // above) conservatively lets the object escape.
         if (SetEscaped(rep)) {
           if (FLAG_trace_turbo_escape) {
             PrintF("Setting #%d (%s) to escaped because of use by #%d (%s)\n",
@@ -686,6 +712,15 @@ void EscapeStatusAnalysis::ProcessFinishRegion(Node* node) {
     info_[node->id()] = kVirtual;
     RevisitUses(node);
   }
+  // The region denotes the same object as its allocation.
+  Node* allocation = NodeProperties::GetValueInput(node, 0);
+  if (IsEscaped(allocation) && SetEscaped(node)) {
+    RevisitUses(node);
+    if (FLAG_trace_turbo_escape) {
+      PrintF("Setting #%d (%s) to escaped because its allocation escapes\n",
+             node->id(), node->op()->mnemonic());
+    }
+  }
   if (CheckUsesForEscape(node, true)) {
     RevisitInputs(node);
   }
@@ -711,6 +746,7 @@ EscapeAnalysis::EscapeAnalysis(Graph* graph, CommonOperatorBuilder* common,
       common_(common),
       zone_(zone),
       virtual_states_(zone),
+      snapshots_(zone),
       replacements_(zone),
       escape_status_(this, graph, zone),
       cache_(zone) {}
@@ -721,6 +757,8 @@ EscapeAnalysis::~EscapeAnalysis() {}
 
 void EscapeAnalysis::Run() {
   replacements_.resize(graph()->NodeCount());
+  // The object analysis already marks some nodes as escaping.
+  escape_status_.Resize();
   RunObjectAnalysis();
   escape_status_.Run();
 }
@@ -728,6 +766,7 @@ void EscapeAnalysis::Run() {
 
 void EscapeAnalysis::RunObjectAnalysis() {
   virtual_states_.resize(graph()->NodeCount());
+  snapshots_.resize(graph()->NodeCount());
   ZoneVector<Node*> stack(zone());
   stack.push_back(graph()->start());
   while (!stack.empty()) {
@@ -818,6 +857,9 @@ bool EscapeAnalysis::Process(Node* node) {
         ForwardVirtualState(node);
       }
       ProcessAllocationUsers(node);
+      if (node->op()->EffectInputCount() > 0) {
+        ProcessFrameStateUses(node);
+      }
       break;
   }
   return true;
@@ -869,12 +911,11 @@ bool EscapeAnalysis::IsEffectBranchPoint(Node* node) {
 
 void EscapeAnalysis::ForwardVirtualState(Node* node) {
   DCHECK_EQ(node->op()->EffectInputCount(), 1);
-  if (node->opcode() != IrOpcode::kLoadField &&
+  if (FLAG_trace_turbo_escape && node->opcode() != IrOpcode::kLoadField &&
       node->opcode() != IrOpcode::kLoadElement &&
       node->opcode() != IrOpcode::kLoad && IsDanglingEffectNode(node)) {
-    PrintF("Dangeling effect node: #%d (%s)\n", node->id(),
+    PrintF("Dangling effect node: #%d (%s)\n", node->id(),
            node->op()->mnemonic());
-    UNREACHABLE();
   }
   Node* effect = NodeProperties::GetEffectInput(node);
   // Break the cycle for effect phis.
@@ -1078,7 +1119,9 @@ bool EscapeAnalysis::IsVirtual(Node* node) {
   if (node->id() >= escape_status_.size()) {
     return false;
   }
-  return escape_status_.IsVirtual(node);
+  // Allocations that flow into phis always escape, so only allocations
+  // themselves can be eliminated.
+  return escape_status_.IsAllocation(node) && escape_status_.IsVirtual(node);
 }
 
 
@@ -1138,10 +1181,11 @@ void EscapeAnalysis::ProcessLoadFromPhi(int offset, Node* from, Node* node,
     if (cache_.fields().size() == cache_.objects().size()) {
       Node* rep = replacement(node);
       if (!rep || !IsEquivalentPhi(rep, cache_.fields())) {
+        int value_input_count = static_cast<int>(cache_.fields().size());
         cache_.fields().push_back(NodeProperties::GetControlInput(from));
         Node* phi = graph()->NewNode(
-            common()->Phi(MachineRepresentation::kTagged, 2),
-            static_cast<int>(cache_.fields().size()), &cache_.fields().front());
+            common()->Phi(MachineRepresentation::kTagged, value_input_count),
+            value_input_count + 1, &cache_.fields().front());
         escape_status_.Resize();
         SetReplacement(node, phi);
         state->LastChangedAt(node);
@@ -1280,6 +1324,136 @@ void EscapeAnalysis::ProcessStoreElement(Node* node) {
 }
 
 
+// Records the virtual objects referenced by the frame states of the effectful
+// {node} (both lazy deopt points and Deoptimize nodes) as they are at {node}.
+void EscapeAnalysis::ProcessFrameStateUses(Node* node) {
+  VirtualState* state = virtual_states_[node->id()];
+  ZoneVector<VirtualObject*>* snapshot = snapshots_[node->id()];
+  if (snapshot != nullptr) {
+    // Take a fresh snapshot, the objects may have changed since last time.
+    snapshot->clear();
+  }
+  for (Node* input : node->inputs()) {
+    if (input->opcode() != IrOpcode::kFrameState) continue;
+    if (snapshot == nullptr) {
+      snapshot = new (zone()) ZoneVector<VirtualObject*>(zone());
+      snapshots_[node->id()] = snapshot;
+    }
+    SnapshotStateValues(state, input, snapshot);
+  }
+}
+
+
+void EscapeAnalysis::SnapshotStateValues(VirtualState* state, Node* node,
+                                         ZoneVector<VirtualObject*>* snapshot) {
+  DCHECK(node->opcode() == IrOpcode::kFrameState ||
+         node->opcode() == IrOpcode::kStateValues);
+  ZoneVector<NodeId> path(zone());
+  for (Node* input : node->inputs()) {
+    if (input->opcode() == IrOpcode::kFrameState ||
+        input->opcode() == IrOpcode::kStateValues) {
+      SnapshotStateValues(state, input, snapshot);
+    } else {
+      SnapshotObject(state, input, snapshot, &path);
+    }
+  }
+}
+
+
+void EscapeAnalysis::SnapshotObject(VirtualState* state, Node* node,
+                                    ZoneVector<VirtualObject*>* snapshot,
+                                    ZoneVector<NodeId>* path) {
+  node = ResolveReplacement(node);
+  if (!escape_status_.IsAllocation(node) || IsEscaped(node)) return;
+  VirtualObject* object = ResolveVirtualObject(state, node);
+  if (object == nullptr || !IsMaterializable(object) ||
+      std::find(path->begin(), path->end(), object->id()) != path->end()) {
+    // The deoptimizer cannot rebuild the object from the information we have
+    // at this point (or the object refers to itself), so it has to exist.
+    if (SetEscaped(node) && FLAG_trace_turbo_escape) {
+      PrintF("Setting #%d (%s) to escaped because it cannot be materialized\n",
+             node->id(), node->op()->mnemonic());
+    }
+    return;
+  }
+  for (VirtualObject* copy : *snapshot) {
+    if (copy->id() == object->id()) return;
+  }
+  snapshot->push_back(new (zone()) VirtualObject(*object));
+  path->push_back(object->id());
+  for (size_t i = 0; i < object->field_count(); ++i) {
+    SnapshotObject(state, object->GetField(i), snapshot, path);
+  }
+  path->pop_back();
+}
+
+
+// Checks whether the deoptimizer is able to materialize {object}, i.e. all of
+// its fields are known and its map is one the deoptimizer knows how to fill.
+bool EscapeAnalysis::IsMaterializable(VirtualObject* object) {
+  if (!object->IsTracked() || object->field_count() == 0) return false;
+  for (size_t i = 0; i < object->field_count(); ++i) {
+    if (object->GetField(i) == nullptr) return false;
+  }
+  HeapObjectMatcher m(object->GetField(HeapObject::kMapOffset / kPointerSize));
+  if (!m.HasValue() || !m.Value()->IsMap()) return false;
+  Handle<Map> map = Handle<Map>::cast(m.Value());
+  int size = static_cast<int>(object->field_count()) * kPointerSize;
+  switch (map->instance_type()) {
+    case JS_OBJECT_TYPE:
+    case JS_ITERATOR_RESULT_TYPE:
+      return map->instance_size() == size;
+    case JS_ARRAY_TYPE:
+      return size == JSArray::kSize;
+    default:
+      return false;
+  }
+}
+
+
+VirtualObject* EscapeAnalysis::GetSnapshot(Node* effect, Node* node) {
+  if (effect->id() >= snapshots_.size()) return nullptr;
+  ZoneVector<VirtualObject*>* snapshot = snapshots_[effect->id()];
+  if (snapshot == nullptr) return nullptr;
+  // Virtual objects are identified by their allocation.
+  if (node->opcode() == IrOpcode::kFinishRegion) {
+    node = NodeProperties::GetValueInput(node, 0);
+  }
+  for (VirtualObject* object : *snapshot) {
+    if (object->id() == node->id()) return object;
+  }
+  return nullptr;
+}
+
+
+Node* EscapeAnalysis::GetOrCreateObjectState(Node* effect, Node* node) {
+  node = ResolveReplacement(node);
+  if (!IsVirtual(node)) return nullptr;
+  VirtualObject* object = GetSnapshot(effect, node);
+  if (object == nullptr) return nullptr;
+  if (Node* object_state = object->GetObjectState()) return object_state;
+  NodeVector fields(zone());
+  for (size_t i = 0; i < object->field_count(); ++i) {
+    Node* field = ResolveReplacement(object->GetField(i));
+    if (Node* field_state = GetOrCreateObjectState(effect, field)) {
+      field = field_state;
+    }
+    fields.push_back(field);
+  }
+  int input_count = static_cast<int>(fields.size());
+  Node* object_state = graph()->NewNode(
+      common()->ObjectState(input_count, static_cast<int>(object->id())),
+      input_count, &fields.front());
+  object->SetObjectState(object_state);
+  if (FLAG_trace_turbo_escape) {
+    PrintF("Created object state #%d for #%d at #%d (%s)\n",
+           object_state->id(), node->id(), effect->id(),
+           effect->op()->mnemonic());
+  }
+  return object_state;
+}
+
+
 void EscapeAnalysis::DebugPrintObject(VirtualObject* object, NodeId id) {
   PrintF("  Object #%d with %zu fields\n", id, object->field_count());
   for (size_t i = 0; i < object->field_count(); ++i) {
@@ -112,6 +112,10 @@ class EscapeAnalysis {
   Node* GetReplacement(Node* node);
   bool IsVirtual(Node* node);
   bool IsEscaped(Node* node);
+  // Returns an ObjectState node that describes the virtual object {node} as
+  // seen by the frame states of the effectful node {effect}, or nullptr if
+  // {node} is not a virtual object there.
+  Node* GetOrCreateObjectState(Node* effect, Node* node);
 
  private:
   void RunObjectAnalysis();
@@ -128,6 +132,14 @@ class EscapeAnalysis {
   bool ProcessEffectPhi(Node* node);
   void ProcessLoadFromPhi(int offset, Node* from, Node* node,
                           VirtualState* states);
+  void ProcessFrameStateUses(Node* node);
+  void SnapshotStateValues(VirtualState* state, Node* node,
+                           ZoneVector<VirtualObject*>* snapshot);
+  void SnapshotObject(VirtualState* state, Node* node,
+                      ZoneVector<VirtualObject*>* snapshot,
+                      ZoneVector<NodeId>* path);
+  bool IsMaterializable(VirtualObject* object);
+  VirtualObject* GetSnapshot(Node* effect, Node* node);
 
   void ForwardVirtualState(Node* node);
 
@@ -159,6 +171,9 @@ class EscapeAnalysis {
   CommonOperatorBuilder* const common_;
   Zone* const zone_;
   ZoneVector<VirtualState*> virtual_states_;
+  // Copies of the virtual objects that the frame states of an effectful node
+  // refer to, taken at that node, indexed by the id of the effectful node.
+  ZoneVector<ZoneVector<VirtualObject*>*> snapshots_;
   ZoneVector<Node*> replacements_;
   EscapeStatusAnalysis escape_status_;
   MergeCache cache_;
@@ -400,6 +400,13 @@ void InstructionSelector::VisitCheckedStore(Node* node) {
 }
 
 
+void InstructionSelector::VisitAtomicLoad(Node* node) {
+  // Aligned loads are sequentially consistent on ia32, as long as
+  // sequentially consistent stores are fenced, which the runtime ensures.
+  VisitLoad(node);
+}
+
+
 // Shared routine for multiple binary operations.
 static void VisitBinop(InstructionSelector* selector, Node* node,
                        InstructionCode opcode, FlagsContinuation* cont) {
@@ -1312,7 +1319,8 @@ InstructionSelector::SupportedMachineOperatorFlags() {
       MachineOperatorBuilder::kFloat64Max |
       MachineOperatorBuilder::kFloat64Min |
       MachineOperatorBuilder::kWord32ShiftIsSafe |
-      MachineOperatorBuilder::kWord32Ctz;
+      MachineOperatorBuilder::kWord32Ctz |
+      MachineOperatorBuilder::kAtomicLoad;
   if (CpuFeatures::IsSupported(POPCNT)) {
     flags |= MachineOperatorBuilder::kWord32Popcnt;
   }
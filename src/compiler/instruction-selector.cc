@@ -320,6 +320,43 @@ InstructionOperand OperandForDeopt(OperandGenerator* g, Node* input,
 }
 
 
+// Appends the descriptor for the frame state value {input} of the given
+// {type} to {descriptor}. Escape analyzed objects show up as ObjectState
+// nodes, whose fields are described recursively.
+void AddStateValueDescriptor(Zone* zone, StateValueDescriptor* descriptor,
+                             Node* input, MachineType type) {
+  if (input->opcode() == IrOpcode::kObjectState) {
+    size_t id = static_cast<size_t>(OpParameter<int>(input));
+    StateValueDescriptor nested = StateValueDescriptor::Recursive(zone, id);
+    for (Node* field : input->inputs()) {
+      AddStateValueDescriptor(zone, &nested, field, MachineType::AnyTagged());
+    }
+    descriptor->fields().push_back(nested);
+  } else {
+    descriptor->fields().push_back(StateValueDescriptor::Plain(zone, type));
+  }
+}
+
+
+// Adds the operands for the frame state value {input}, which is described by
+// {descriptor}, to {inputs}.
+void AddOperandsForStateValue(OperandGenerator* g,
+                              InstructionOperandVector* inputs,
+                              StateValueDescriptor* descriptor, Node* input,
+                              FrameStateInputKind kind) {
+  if (descriptor->IsNested()) {
+    DCHECK_EQ(IrOpcode::kObjectState, input->opcode());
+    DCHECK_EQ(descriptor->size(), static_cast<size_t>(input->InputCount()));
+    for (int i = 0; i < input->InputCount(); ++i) {
+      AddOperandsForStateValue(g, inputs, &descriptor->fields()[i],
+                               input->InputAt(i), kind);
+    }
+  } else {
+    inputs->push_back(OperandForDeopt(g, input, kind));
+  }
+}
+
+
 void AddFrameStateInputs(Node* state, OperandGenerator* g,
                          InstructionOperandVector* inputs,
                          FrameStateDescriptor* descriptor,
@@ -342,30 +379,30 @@ void AddFrameStateInputs(Node* state, OperandGenerator* g,
   DCHECK_EQ(descriptor->locals_count(), StateValuesAccess(locals).size());
   DCHECK_EQ(descriptor->stack_count(), StateValuesAccess(stack).size());
 
-  ZoneVector<MachineType> types(zone);
-  types.reserve(descriptor->GetSize());
+  StateValueDescriptor* values = descriptor->GetStateValueDescriptor();
+  DCHECK_EQ(descriptor->GetSize(), values->size());
 
   size_t value_index = 0;
   inputs->push_back(
       OperandForDeopt(g, function, FrameStateInputKind::kStackSlot));
-  descriptor->SetType(value_index++, MachineType::AnyTagged());
+  value_index++;
   for (StateValuesAccess::TypedNode input_node :
        StateValuesAccess(parameters)) {
-    inputs->push_back(OperandForDeopt(g, input_node.node, kind));
-    descriptor->SetType(value_index++, input_node.type);
+    AddOperandsForStateValue(g, inputs, &values->fields()[value_index++],
+                             input_node.node, kind);
   }
   if (descriptor->HasContext()) {
     inputs->push_back(
         OperandForDeopt(g, context, FrameStateInputKind::kStackSlot));
-    descriptor->SetType(value_index++, MachineType::AnyTagged());
+    value_index++;
   }
   for (StateValuesAccess::TypedNode input_node : StateValuesAccess(locals)) {
-    inputs->push_back(OperandForDeopt(g, input_node.node, kind));
-    descriptor->SetType(value_index++, input_node.type);
+    AddOperandsForStateValue(g, inputs, &values->fields()[value_index++],
+                             input_node.node, kind);
   }
   for (StateValuesAccess::TypedNode input_node : StateValuesAccess(stack)) {
-    inputs->push_back(OperandForDeopt(g, input_node.node, kind));
-    descriptor->SetType(value_index++, input_node.type);
+    AddOperandsForStateValue(g, inputs, &values->fields()[value_index++],
+                             input_node.node, kind);
   }
   DCHECK(value_index == descriptor->GetSize());
 }
@@ -752,6 +789,7 @@ void InstructionSelector::VisitNode(Node* node) {
       return VisitCall(node);
     case IrOpcode::kFrameState:
     case IrOpcode::kStateValues:
+    case IrOpcode::kObjectState:
       return;
     case IrOpcode::kLoad: {
       LoadRepresentation type = LoadRepresentationOf(node->op());
@@ -988,6 +1026,11 @@ void InstructionSelector::VisitNode(Node* node) {
     }
     case IrOpcode::kCheckedStore:
       return VisitCheckedStore(node);
+    case IrOpcode::kAtomicLoad: {
+      LoadRepresentation type = LoadRepresentationOf(node->op());
+      MarkAsRepresentation(type.representation(), node);
+      return VisitAtomicLoad(node);
+    }
     default:
       V8_Fatal(__FILE__, __LINE__, "Unexpected operator #%d:%s @ node #%d",
                node->opcode(), node->op()->mnemonic(), node->id());
@@ -1525,10 +1568,37 @@ FrameStateDescriptor* InstructionSelector::GetFrameStateDescriptor(
     outer_state = GetFrameStateDescriptor(outer_node);
   }
 
-  return new (instruction_zone()) FrameStateDescriptor(
-      instruction_zone(), state_info.type(), state_info.bailout_id(),
-      state_info.state_combine(), parameters, locals, stack,
-      state_info.shared_info(), outer_state);
+  FrameStateDescriptor* descriptor = new (instruction_zone())
+      FrameStateDescriptor(instruction_zone(), state_info.type(),
+                           state_info.bailout_id(), state_info.state_combine(),
+                           parameters, locals, stack, state_info.shared_info(),
+                           outer_state);
+
+  // Describe the values of all slots up front, so that the total number of
+  // operands (including the fields of nested objects) is known before the
+  // operands are generated.
+  Zone* zone = instruction_zone();
+  StateValueDescriptor* values = descriptor->GetStateValueDescriptor();
+  values->fields().push_back(
+      StateValueDescriptor::Plain(zone, MachineType::AnyTagged()));
+  for (StateValuesAccess::TypedNode input_node :
+       StateValuesAccess(state->InputAt(kFrameStateParametersInput))) {
+    AddStateValueDescriptor(zone, values, input_node.node, input_node.type);
+  }
+  if (descriptor->HasContext()) {
+    values->fields().push_back(
+        StateValueDescriptor::Plain(zone, MachineType::AnyTagged()));
+  }
+  for (StateValuesAccess::TypedNode input_node :
+       StateValuesAccess(state->InputAt(kFrameStateLocalsInput))) {
+    AddStateValueDescriptor(zone, values, input_node.node, input_node.type);
+  }
+  for (StateValuesAccess::TypedNode input_node :
+       StateValuesAccess(state->InputAt(kFrameStateStackInput))) {
+    AddStateValueDescriptor(zone, values, input_node.node, input_node.type);
+  }
+  DCHECK_EQ(descriptor->GetSize(), values->size());
+  return descriptor;
 }
 
 
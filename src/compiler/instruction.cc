@@ -831,11 +831,9 @@ FrameStateDescriptor::FrameStateDescriptor(
       parameters_count_(parameters_count),
       locals_count_(locals_count),
       stack_count_(stack_count),
-      types_(zone),
+      values_(zone),
       shared_info_(shared_info),
-      outer_state_(outer_state) {
-  types_.resize(GetSize(), MachineType::None());
-}
+      outer_state_(outer_state) {}
 
 
 size_t FrameStateDescriptor::GetSize(OutputFrameStateCombine combine) const {
@@ -856,7 +854,7 @@ size_t FrameStateDescriptor::GetTotalSize() const {
   size_t total_size = 0;
   for (const FrameStateDescriptor* iter = this; iter != NULL;
        iter = iter->outer_state_) {
-    total_size += iter->GetSize();
+    total_size += iter->values_.GetOperandCount();
   }
   return total_size;
 }
@@ -884,14 +882,13 @@ size_t FrameStateDescriptor::GetJSFrameCount() const {
 }
 
 
-MachineType FrameStateDescriptor::GetType(size_t index) const {
-  return types_[index];
-}
-
-
-void FrameStateDescriptor::SetType(size_t index, MachineType type) {
-  DCHECK(index < GetSize());
-  types_[index] = type;
+size_t StateValueDescriptor::GetOperandCount() const {
+  if (IsPlain()) return 1;
+  size_t count = 0;
+  for (const StateValueDescriptor& field : fields_) {
+    count += field.GetOperandCount();
+  }
+  return count;
 }
 
 
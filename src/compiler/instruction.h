@@ -941,6 +941,49 @@ class Constant final {
 };
 
 
+// A StateValueDescriptor describes one value of a frame state: either a plain
+// value of a given machine type that occupies one instruction operand, or a
+// nested (escape analyzed) object whose fields are described by further
+// descriptors and which is materialized by the deoptimizer.
+class StateValueDescriptor {
+ public:
+  explicit StateValueDescriptor(Zone* zone)
+      : kind_(kNested),
+        type_(MachineType::AnyTagged()),
+        id_(0),
+        fields_(zone) {}
+
+  static StateValueDescriptor Plain(Zone* zone, MachineType type) {
+    return StateValueDescriptor(kPlain, zone, type, 0);
+  }
+  static StateValueDescriptor Recursive(Zone* zone, size_t id) {
+    return StateValueDescriptor(kNested, zone, MachineType::AnyTagged(), id);
+  }
+
+  bool IsPlain() const { return kind_ == kPlain; }
+  bool IsNested() const { return kind_ == kNested; }
+  MachineType type() const { return type_; }
+  size_t id() const { return id_; }
+  size_t size() const { return fields_.size(); }
+  ZoneVector<StateValueDescriptor>& fields() { return fields_; }
+  const ZoneVector<StateValueDescriptor>& fields() const { return fields_; }
+
+  // Number of instruction operands needed to describe this value.
+  size_t GetOperandCount() const;
+
+ private:
+  enum Kind { kPlain, kNested };
+
+  StateValueDescriptor(Kind kind, Zone* zone, MachineType type, size_t id)
+      : kind_(kind), type_(type), id_(id), fields_(zone) {}
+
+  Kind kind_;
+  MachineType type_;
+  size_t id_;
+  ZoneVector<StateValueDescriptor> fields_;
+};
+
+
 class FrameStateDescriptor : public ZoneObject {
  public:
   FrameStateDescriptor(Zone* zone, FrameStateType type, BailoutId bailout_id,
@@ -962,14 +1005,18 @@ class FrameStateDescriptor : public ZoneObject {
     return FrameStateFunctionInfo::IsJSFunctionType(type_);
   }
 
+  // Number of slots in this frame, i.e. the number of values that the
+  // translation for this frame describes at the top level.
   size_t GetSize(OutputFrameStateCombine combine =
                      OutputFrameStateCombine::Ignore()) const;
+  // Number of instruction operands for this frame and all outer frames; this
+  // exceeds the number of slots if some slots hold nested objects.
   size_t GetTotalSize() const;
   size_t GetFrameCount() const;
   size_t GetJSFrameCount() const;
 
-  MachineType GetType(size_t index) const;
-  void SetType(size_t index, MachineType type);
+  // Describes the values of the slots of this frame, one field per slot.
+  StateValueDescriptor* GetStateValueDescriptor() { return &values_; }
 
  private:
   FrameStateType type_;
@@ -978,7 +1025,7 @@ class FrameStateDescriptor : public ZoneObject {
   size_t parameters_count_;
   size_t locals_count_;
   size_t stack_count_;
-  ZoneVector<MachineType> types_;
+  StateValueDescriptor values_;
   MaybeHandle<SharedFunctionInfo> const shared_info_;
   FrameStateDescriptor* outer_state_;
 };
@@ -595,7 +595,10 @@ Node* InterpreterAssembler::Advance(Node* delta) {
 }
 
 
-void InterpreterAssembler::Jump(Node* delta) { DispatchTo(Advance(delta)); }
+void InterpreterAssembler::Jump(Node* delta) {
+  StackCheckOnBackwardJump(delta);
+  DispatchTo(Advance(delta));
+}
 
 
 void InterpreterAssembler::JumpIfWordEqual(Node* lhs, Node* rhs, Node* delta) {
@@ -603,20 +606,92 @@ void InterpreterAssembler::JumpIfWordEqual(Node* lhs, Node* rhs, Node* delta) {
   Node* condition = raw_assembler_->WordEqual(lhs, rhs);
   raw_assembler_->Branch(condition, &match, &no_match);
   raw_assembler_->Bind(&match);
+  StackCheckOnBackwardJump(delta);
   DispatchTo(Advance(delta));
   raw_assembler_->Bind(&no_match);
-  Dispatch();
+  DispatchTo(Advance(interpreter::Bytecodes::Size(bytecode_)));
+}
+
+
+void InterpreterAssembler::StackCheckOnBackwardJump(Node* delta) {
+  // Backward jumps close loops, so check for pending interrupts (e.g. stack
+  // guard requests, termination or runtime profiler ticks) before jumping.
+  // Forward jumps skip the check altogether.
+  RawMachineLabel backward, stack_guard, done;
+  raw_assembler_->Branch(
+      raw_assembler_->IntPtrLessThan(delta, IntPtrConstant(0)), &backward,
+      &done);
+  raw_assembler_->Bind(&backward);
+  Node* stack_limit = raw_assembler_->Load(
+      MachineType::Pointer(),
+      raw_assembler_->ExternalConstant(
+          ExternalReference::address_of_stack_limit(isolate())));
+  Node* interrupt = raw_assembler_->UintPtrLessThan(
+      raw_assembler_->LoadStackPointer(), stack_limit);
+  raw_assembler_->Branch(interrupt, &stack_guard, &done);
+  raw_assembler_->Bind(&stack_guard);
+  // The bytecode offset is unchanged by the runtime call, so there is no need
+  // for the call epilogue to reload it from the frame.
+  CallPrologue();
+  raw_assembler_->CallRuntime0(Runtime::kStackGuard, GetContext());
+  raw_assembler_->Goto(&done);
+  raw_assembler_->Bind(&done);
 }
 
 
 void InterpreterAssembler::Dispatch() {
-  DispatchTo(Advance(interpreter::Bytecodes::Size(bytecode_)));
+  Node* next_bytecode_offset = Advance(interpreter::Bytecodes::Size(bytecode_));
+  if (interpreter::Bytecodes::IsStarLookahead(bytecode_)) {
+    DispatchWithStarLookahead(next_bytecode_offset);
+  } else {
+    DispatchTo(next_bytecode_offset);
+  }
+}
+
+
+void InterpreterAssembler::DispatchWithStarLookahead(
+    Node* next_bytecode_offset) {
+  RawMachineLabel inline_star, dispatch;
+  Node* next_bytecode = LoadBytecode(next_bytecode_offset);
+  Node* star_bytecode = Int32Constant(
+      interpreter::Bytecodes::ToByte(interpreter::Bytecode::kStar));
+  Node* is_star = raw_assembler_->Word32Equal(next_bytecode, star_bytecode);
+  raw_assembler_->Branch(is_star, &inline_star, &dispatch);
+
+  raw_assembler_->Bind(&inline_star);
+  {
+    // Execute the Star as if we were its handler, then dispatch to whatever
+    // follows it, saving an indirect jump for the (bytecode, Star) pair.
+    if (FLAG_trace_ignition_dispatches) TraceBytecodeDispatch(next_bytecode);
+    interpreter::Bytecode previous_bytecode = bytecode_;
+    Node* previous_bytecode_offset = bytecode_offset_;
+    bytecode_ = interpreter::Bytecode::kStar;
+    bytecode_offset_ = next_bytecode_offset;
+    StoreRegister(GetAccumulator(), BytecodeOperandReg(0));
+    DispatchTo(Advance(interpreter::Bytecodes::Size(bytecode_)));
+    bytecode_ = previous_bytecode;
+    bytecode_offset_ = previous_bytecode_offset;
+  }
+
+  raw_assembler_->Bind(&dispatch);
+  DispatchToBytecode(next_bytecode, next_bytecode_offset);
+}
+
+
+Node* InterpreterAssembler::LoadBytecode(Node* bytecode_offset) {
+  return raw_assembler_->Load(MachineType::Uint8(),
+                              BytecodeArrayTaggedPointer(), bytecode_offset);
 }
 
 
 void InterpreterAssembler::DispatchTo(Node* new_bytecode_offset) {
-  Node* target_bytecode = raw_assembler_->Load(
-      MachineType::Uint8(), BytecodeArrayTaggedPointer(), new_bytecode_offset);
+  DispatchToBytecode(LoadBytecode(new_bytecode_offset), new_bytecode_offset);
+}
+
+
+void InterpreterAssembler::DispatchToBytecode(Node* target_bytecode,
+                                              Node* new_bytecode_offset) {
+  if (FLAG_trace_ignition_dispatches) TraceBytecodeDispatch(target_bytecode);
 
   // TODO(rmcilroy): Create a code target dispatch table to avoid conversion
   // from code object on every dispatch.
@@ -642,6 +717,27 @@ void InterpreterAssembler::DispatchTo(Node* new_bytecode_offset) {
 }
 
 
+void InterpreterAssembler::TraceBytecodeDispatch(Node* target_bytecode) {
+  // The counters table is a square matrix indexed by [source][target], and
+  // the source bytecode is known statically.
+  static const int kTableRowSize =
+      (static_cast<int>(interpreter::Bytecode::kLast) + 1) * kPointerSize;
+  Node* counters_table = raw_assembler_->ExternalConstant(
+      ExternalReference::interpreter_dispatch_counters(isolate()));
+  Node* source_row = IntPtrAdd(
+      counters_table,
+      IntPtrConstant(interpreter::Bytecodes::ToByte(bytecode_) *
+                     kTableRowSize));
+  Node* counter_offset = raw_assembler_->Word32Shl(
+      target_bytecode, Int32Constant(kPointerSizeLog2));
+  Node* old_counter =
+      raw_assembler_->Load(MachineType::IntPtr(), source_row, counter_offset);
+  Node* new_counter = IntPtrAdd(old_counter, IntPtrConstant(1));
+  raw_assembler_->Store(MachineType::PointerRepresentation(), source_row,
+                        counter_offset, new_counter, kNoWriteBarrier);
+}
+
+
 void InterpreterAssembler::Abort(BailoutReason bailout_reason) {
   Node* abort_id = SmiTag(Int32Constant(bailout_reason));
   Node* ret_value = CallRuntime(Runtime::kAbort, abort_id);
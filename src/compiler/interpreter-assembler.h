@@ -190,9 +190,27 @@ class InterpreterAssembler {
   Node* Advance(int delta);
   Node* Advance(Node* delta);
 
+  // Calls the stack guard if |delta| jumps backwards and an interrupt has
+  // been requested.
+  void StackCheckOnBackwardJump(Node* delta);
+
   // Starts next instruction dispatch at |new_bytecode_offset|.
   void DispatchTo(Node* new_bytecode_offset);
 
+  // Dispatches to |target_bytecode| located at |new_bytecode_offset|.
+  void DispatchToBytecode(Node* target_bytecode, Node* new_bytecode_offset);
+
+  // Dispatches to the bytecode at |next_bytecode_offset|, executing it inline
+  // if it is a Star and then dispatching to the bytecode following the Star.
+  void DispatchWithStarLookahead(Node* next_bytecode_offset);
+
+  // Loads the bytecode at |bytecode_offset| in the current bytecode array.
+  Node* LoadBytecode(Node* bytecode_offset);
+
+  // Increments the counter for dispatches from the current bytecode to
+  // |target_bytecode| (only used when --trace-ignition-dispatches is enabled).
+  void TraceBytecodeDispatch(Node* target_bytecode);
+
   // Abort operations for debug code.
   void AbortIfWordNotEqual(Node* lhs, Node* rhs, BailoutReason bailout_reason);
 
@@ -5,13 +5,51 @@
 #include "src/compiler/js-inlining-heuristic.h"
 
 #include "src/compiler.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/js-graph.h"
 #include "src/compiler/node-matchers.h"
+#include "src/compiler/simplified-operator.h"
 #include "src/objects-inl.h"
 
 namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Collects the distinct functions that the {node} can evaluate to, which is
+// either a single constant function or a phi of up to {functions_size}
+// constant functions. Returns 0 if the {node} is not of that shape.
+int CollectFunctions(Node* node, Handle<JSFunction>* functions,
+                     int functions_size) {
+  DCHECK_LT(0, functions_size);
+  HeapObjectMatcher m(node);
+  if (m.HasValue() && m.Value()->IsJSFunction()) {
+    functions[0] = Handle<JSFunction>::cast(m.Value());
+    return 1;
+  }
+  if (node->opcode() != IrOpcode::kPhi) return 0;
+  int const value_input_count = node->op()->ValueInputCount();
+  if (value_input_count > functions_size) return 0;
+  int num_functions = 0;
+  for (int i = 0; i < value_input_count; ++i) {
+    HeapObjectMatcher m(node->InputAt(i));
+    if (!m.HasValue() || !m.Value()->IsJSFunction()) return 0;
+    Handle<JSFunction> function = Handle<JSFunction>::cast(m.Value());
+    for (int j = 0; j < num_functions; ++j) {
+      if (functions[j].is_identical_to(function)) {
+        function = Handle<JSFunction>::null();
+        break;
+      }
+    }
+    if (!function.is_null()) functions[num_functions++] = function;
+  }
+  return num_functions;
+}
+
+}  // namespace
+
+
 Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (!IrOpcode::IsInlineeOpcode(node->opcode())) return NoChange();
 
@@ -19,14 +57,26 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   if (seen_.find(node->id()) != seen_.end()) return NoChange();
   seen_.insert(node->id());
 
-  Node* callee = node->InputAt(0);
-  HeapObjectMatcher match(callee);
-  if (!match.HasValue() || !match.Value()->IsJSFunction()) return NoChange();
-  Handle<JSFunction> function = Handle<JSFunction>::cast(match.Value());
+  Candidate candidate;
+  candidate.node = node;
+  candidate.calls = -1;  // Same default as CallICNexus::ExtractCallCount.
+  candidate.total_size = 0;
+  candidate.num_functions =
+      CollectFunctions(node->InputAt(0), candidate.functions,
+                       FLAG_turbo_polymorphic_inlining ? kMaxCallPolymorphism
+                                                       : 1);
+  if (candidate.num_functions == 0) return NoChange();
+  if (candidate.num_functions > 1) {
+    // Polymorphic call sites are expanded into a dispatch on the target,
+    // which is only supported for calls without exceptional continuation.
+    if (node->opcode() != IrOpcode::kJSCallFunction) return NoChange();
+    if (NodeProperties::IsExceptionalCall(node)) return NoChange();
+  }
 
   // Functions marked with %SetForceInlineFlag are immediately inlined.
-  if (function->shared()->force_inline()) {
-    return inliner_.ReduceJSCall(node, function);
+  if (candidate.num_functions == 1 &&
+      candidate.functions[0]->shared()->force_inline()) {
+    return inliner_.ReduceJSCall(node, candidate.functions[0]);
   }
 
   // Handling of special inlining modes right away:
@@ -36,7 +86,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
     case kRestrictedInlining:
       return NoChange();
     case kStressInlining:
-      return inliner_.ReduceJSCall(node, function);
+      return InlineCandidate(candidate);
     case kGeneralInlining:
       break;
   }
@@ -45,25 +95,31 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // Everything below this line is part of the inlining heuristic.
   // ---------------------------------------------------------------------------
 
-  // Built-in functions are handled by the JSBuiltinReducer.
-  if (function->shared()->HasBuiltinFunctionId()) return NoChange();
+  // Avoid inlining within or across the boundary of asm.js code.
+  if (info_->shared_info()->asm_function()) return NoChange();
+
+  for (int i = 0; i < candidate.num_functions; ++i) {
+    Handle<SharedFunctionInfo> shared(candidate.functions[i]->shared());
 
-  // Don't inline builtins.
-  if (function->shared()->IsBuiltin()) return NoChange();
+    // Built-in functions are handled by the JSBuiltinReducer.
+    if (shared->HasBuiltinFunctionId()) return NoChange();
 
-  // Quick check on source code length to avoid parsing large candidate.
-  if (function->shared()->SourceSize() > FLAG_max_inlined_source_size) {
-    return NoChange();
-  }
+    // Don't inline builtins.
+    if (shared->IsBuiltin()) return NoChange();
 
-  // Quick check on the size of the AST to avoid parsing large candidate.
-  if (function->shared()->ast_node_count() > FLAG_max_inlined_nodes) {
-    return NoChange();
-  }
+    // Quick check on source code length to avoid parsing large candidate.
+    if (shared->SourceSize() > FLAG_max_inlined_source_size) {
+      return NoChange();
+    }
 
-  // Avoid inlining within or across the boundary of asm.js code.
-  if (info_->shared_info()->asm_function()) return NoChange();
-  if (function->shared()->asm_function()) return NoChange();
+    // Quick check on the size of the AST to avoid parsing large candidate.
+    if (shared->ast_node_count() > FLAG_max_inlined_nodes) return NoChange();
+
+    // Avoid inlining across the boundary of asm.js code.
+    if (shared->asm_function()) return NoChange();
+
+    candidate.total_size += shared->ast_node_count();
+  }
 
   // Stop inlinining once the maximum allowed level is reached.
   int level = 0;
@@ -74,13 +130,12 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   }
 
   // Gather feedback on how often this call site has been hit before.
-  int calls = -1;  // Same default as CallICNexus::ExtractCallCount.
   // TODO(turbofan): We also want call counts for constructor calls.
   if (node->opcode() == IrOpcode::kJSCallFunction) {
     CallFunctionParameters p = CallFunctionParametersOf(node->op());
     if (p.feedback().IsValid()) {
       CallICNexus nexus(p.feedback().vector(), p.feedback().slot());
-      calls = nexus.ExtractCallCount();
+      candidate.calls = nexus.ExtractCallCount();
     }
   }
 
@@ -89,7 +144,7 @@ Reduction JSInliningHeuristic::Reduce(Node* node) {
   // ---------------------------------------------------------------------------
 
   // In the general case we remember the candidate for later.
-  candidates_.insert({function, node, calls});
+  candidates_.insert(candidate);
   return NoChange();
 }
 
@@ -108,17 +163,80 @@ void JSInliningHeuristic::Finalize() {
     Candidate candidate = *i;
     candidates_.erase(i);
     // Make sure we don't try to inline dead candidate nodes.
-    if (!candidate.node->IsDead()) {
-      Reduction r = inliner_.ReduceJSCall(candidate.node, candidate.function);
-      if (r.Changed()) {
-        cumulative_count_ += candidate.function->shared()->ast_node_count();
-        return;
-      }
+    if (candidate.node->IsDead()) continue;
+    // Candidates that don't fit into the remaining budget are skipped in
+    // favor of smaller ones, unless they are small enough to be allowed to
+    // overshoot it.
+    if (candidate.total_size > FLAG_max_inlined_nodes_small &&
+        cumulative_count_ + candidate.total_size >
+            FLAG_max_inlined_nodes_cumulative) {
+      continue;
+    }
+    Reduction r = InlineCandidate(candidate);
+    if (r.Changed()) {
+      cumulative_count_ += candidate.total_size;
+      return;
     }
   }
 }
 
 
+Reduction JSInliningHeuristic::InlineCandidate(Candidate const& candidate) {
+  int const num_calls = candidate.num_functions;
+  Node* const node = candidate.node;
+  if (num_calls == 1) {
+    return inliner_.ReduceJSCall(node, candidate.functions[0]);
+  }
+
+  // Expand the {node} into a dispatch on the identity of the target, with
+  // one call per target function, and then try to inline each of these.
+  Node* calls[kMaxCallPolymorphism + 1];
+  Node* if_successes[kMaxCallPolymorphism];
+  Node* callee = NodeProperties::GetValueInput(node, 0);
+  Node* control = NodeProperties::GetControlInput(node);
+  int const input_count = node->InputCount();
+  int const control_index = NodeProperties::FirstControlIndex(node);
+  Node** inputs = graph()->zone()->NewArray<Node*>(input_count);
+  for (int i = 0; i < input_count; ++i) inputs[i] = node->InputAt(i);
+  for (int i = 0; i < num_calls; ++i) {
+    Node* target = jsgraph()->HeapConstant(candidate.functions[i]);
+    if (i != (num_calls - 1)) {
+      Node* check = graph()->NewNode(
+          simplified()->ReferenceEqual(Type::Tagged()), callee, target);
+      Node* branch = graph()->NewNode(common()->Branch(), check, control);
+      control = graph()->NewNode(common()->IfFalse(), branch);
+      inputs[control_index] = graph()->NewNode(common()->IfTrue(), branch);
+    } else {
+      // The {callee} is a phi of the target functions, so it must be the
+      // last one if it's none of the others.
+      inputs[control_index] = control;
+    }
+    inputs[0] = target;
+    calls[i] = graph()->NewNode(node->op(), input_count, inputs);
+    if_successes[i] = graph()->NewNode(common()->IfSuccess(), calls[i]);
+  }
+
+  // Merge the results of the individual calls.
+  control = graph()->NewNode(common()->Merge(num_calls), num_calls,
+                             if_successes);
+  calls[num_calls] = control;
+  Node* effect =
+      graph()->NewNode(common()->EffectPhi(num_calls), num_calls + 1, calls);
+  Node* value = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, num_calls), num_calls + 1,
+      calls);
+  ReplaceWithValue(node, value, effect, control);
+  node->Kill();
+
+  // Inline the individual calls, whatever doesn't get inlined remains a
+  // direct call to a known function.
+  for (int i = 0; i < num_calls; ++i) {
+    inliner_.ReduceJSCall(calls[i], candidate.functions[i]);
+  }
+  return Replace(value);
+}
+
+
 bool JSInliningHeuristic::CandidateCompare::operator()(
     const Candidate& left, const Candidate& right) const {
   return left.node != right.node && left.calls >= right.calls;
@@ -128,14 +246,29 @@ bool JSInliningHeuristic::CandidateCompare::operator()(
 void JSInliningHeuristic::PrintCandidates() {
   PrintF("Candidates for inlining (size=%zu):\n", candidates_.size());
   for (const Candidate& candidate : candidates_) {
-    PrintF("  id:%d, calls:%d, size[source]:%d, size[ast]:%d / %s\n",
-           candidate.node->id(), candidate.calls,
-           candidate.function->shared()->SourceSize(),
-           candidate.function->shared()->ast_node_count(),
-           candidate.function->shared()->DebugName()->ToCString().get());
+    PrintF("  id:%d, calls:%d, size[ast]:%d\n", candidate.node->id(),
+           candidate.calls, candidate.total_size);
+    for (int i = 0; i < candidate.num_functions; ++i) {
+      Handle<SharedFunctionInfo> shared(candidate.functions[i]->shared());
+      PrintF("  - size[source]:%d, size[ast]:%d / %s\n", shared->SourceSize(),
+             shared->ast_node_count(), shared->DebugName()->ToCString().get());
+    }
   }
 }
 
+
+CommonOperatorBuilder* JSInliningHeuristic::common() const {
+  return jsgraph()->common();
+}
+
+
+Graph* JSInliningHeuristic::graph() const { return jsgraph()->graph(); }
+
+
+SimplifiedOperatorBuilder* JSInliningHeuristic::simplified() const {
+  return jsgraph()->simplified();
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
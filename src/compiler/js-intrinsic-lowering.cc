@@ -33,8 +33,47 @@ Reduction JSIntrinsicLowering::Reduce(Node* node) {
   if (node->opcode() != IrOpcode::kJSCallRuntime) return NoChange();
   const Runtime::Function* const f =
       Runtime::FunctionForId(CallRuntimeParametersOf(node->op()).id());
-  if (f->intrinsic_type != Runtime::IntrinsicType::INLINE) return NoChange();
+  if (f->intrinsic_type != Runtime::IntrinsicType::INLINE) {
+    Factory* const factory = isolate()->factory();
+    switch (f->function_id) {
+      case Runtime::kFloat32x4ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->float32x4_map(), 4,
+                                        type_cache_.kFloat32,
+                                        MachineType::Float32());
+      case Runtime::kInt32x4ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->int32x4_map(), 4,
+                                        type_cache_.kInt32,
+                                        MachineType::Int32());
+      case Runtime::kUint32x4ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->uint32x4_map(), 4,
+                                        type_cache_.kUint32,
+                                        MachineType::Uint32());
+      case Runtime::kInt16x8ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->int16x8_map(), 8,
+                                        type_cache_.kInt16,
+                                        MachineType::Int16());
+      case Runtime::kUint16x8ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->uint16x8_map(), 8,
+                                        type_cache_.kUint16,
+                                        MachineType::Uint16());
+      case Runtime::kInt8x16ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->int8x16_map(), 16,
+                                        type_cache_.kInt8,
+                                        MachineType::Int8());
+      case Runtime::kUint8x16ExtractLane:
+        return ReduceSimd128ExtractLane(node, factory->uint8x16_map(), 16,
+                                        type_cache_.kUint8,
+                                        MachineType::Uint8());
+      default:
+        break;
+    }
+    return NoChange();
+  }
   switch (f->function_id) {
+    case Runtime::kInlineAtomicsIsLockFree:
+      return ReduceAtomicsIsLockFree(node);
+    case Runtime::kInlineAtomicsLoad:
+      return ReduceAtomicsLoad(node);
     case Runtime::kInlineConstructDouble:
       return ReduceConstructDouble(node);
     case Runtime::kInlineCreateIterResultObject:
@@ -118,6 +157,73 @@ Reduction JSIntrinsicLowering::Reduce(Node* node) {
 }
 
 
+Reduction JSIntrinsicLowering::ReduceAtomicsIsLockFree(Node* node) {
+  NumberMatcher m(NodeProperties::GetValueInput(node, 0));
+  if (!m.HasValue()) return NoChange();
+  uint32_t const size = DoubleToUint32(m.Value());
+  Node* value = jsgraph()->BooleanConstant(size == 1 || size == 2 || size == 4);
+  ReplaceWithValue(node, value);
+  return Replace(value);
+}
+
+
+Reduction JSIntrinsicLowering::ReduceAtomicsLoad(Node* node) {
+  const OptionalOperator load = machine()->AtomicLoad(MachineType::Int32());
+  if (!load.IsSupported()) return NoChange();
+  if (NodeProperties::IsExceptionalCall(node)) return NoChange();
+
+  // The caller has already checked that |array| is an integer typed array
+  // on a SharedArrayBuffer and that |index| is in bounds, so the elements are
+  // always external. Only Int32Array is handled inline, everything else goes
+  // to the runtime.
+  Node* array = NodeProperties::GetValueInput(node, 0);
+  Node* index = NodeProperties::GetValueInput(node, 1);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+
+  Node* elements = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectElements()), array,
+      effect, control);
+  Node* elements_map =
+      graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()),
+                       elements, elements, control);
+  Node* check = graph()->NewNode(
+      simplified()->ReferenceEqual(Type::Any()), elements_map,
+      jsgraph()->HeapConstant(isolate()->factory()->fixed_int32_array_map()));
+  Node* branch =
+      graph()->NewNode(common()->Branch(BranchHint::kTrue), check, control);
+
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* external_pointer = graph()->NewNode(
+      simplified()->LoadField(
+          AccessBuilder::ForFixedTypedArrayBaseExternalPointer()),
+      elements, elements_map, if_true);
+  Node* offset = graph()->NewNode(
+      machine()->Word32Shl(), index,
+      jsgraph()->Int32Constant(
+          ElementSizeLog2Of(MachineRepresentation::kWord32)));
+  if (machine()->Is64()) {
+    offset = graph()->NewNode(machine()->ChangeUint32ToUint64(), offset);
+  }
+  Node* etrue = graph()->NewNode(load.op(), external_pointer, offset,
+                                 external_pointer, if_true);
+  Node* vtrue = etrue;
+
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* vfalse = graph()->CloneNode(node);
+  NodeProperties::ReplaceEffectInput(vfalse, elements_map);
+  NodeProperties::ReplaceControlInput(vfalse, if_false);
+  Node* efalse = vfalse;
+
+  control = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  effect = graph()->NewNode(common()->EffectPhi(2), etrue, efalse, control);
+  Node* value = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kTagged, 2), vtrue, vfalse, control);
+  ReplaceWithValue(node, value, effect, control);
+  return Replace(value);
+}
+
+
 Reduction JSIntrinsicLowering::ReduceCreateIterResultObject(Node* node) {
   Node* const value = NodeProperties::GetValueInput(node, 0);
   Node* const done = NodeProperties::GetValueInput(node, 1);
@@ -522,6 +628,66 @@ Reduction JSIntrinsicLowering::ReduceRegExpSource(Node* node) {
 }
 
 
+Reduction JSIntrinsicLowering::ReduceSimd128ExtractLane(
+    Node* node, Handle<Map> map, int lane_count, Type* lane_type,
+    MachineType lane_machine_type) {
+  // Only constant lanes can be turned into field loads, and the runtime call
+  // must stay the single point that can throw.
+  NumberMatcher m(NodeProperties::GetValueInput(node, 1));
+  if (!m.HasValue() || !IsInt32Double(m.Value())) return NoChange();
+  int const lane = static_cast<int>(m.Value());
+  if (lane < 0 || lane >= lane_count) return NoChange();
+  if (NodeProperties::IsExceptionalCall(node)) return NoChange();
+
+  // if (!%_IsSmi(value) && %_GetMap(value) == map) {
+  //   return value.lanes[lane];
+  // } else {
+  //   return %TypeExtractLane(value, lane);
+  // }
+  Node* value = NodeProperties::GetValueInput(node, 0);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+
+  Node* check0 = graph()->NewNode(simplified()->ObjectIsSmi(), value);
+  Node* branch0 = graph()->NewNode(common()->Branch(BranchHint::kFalse),
+                                   check0, control);
+
+  Node* if_smi = graph()->NewNode(common()->IfTrue(), branch0);
+  Node* if_not_smi = graph()->NewNode(common()->IfFalse(), branch0);
+
+  Node* value_map =
+      graph()->NewNode(simplified()->LoadField(AccessBuilder::ForMap()), value,
+                       effect, if_not_smi);
+  Node* check1 = graph()->NewNode(simplified()->ReferenceEqual(Type::Any()),
+                                  value_map, jsgraph()->HeapConstant(map));
+  Node* branch1 = graph()->NewNode(common()->Branch(BranchHint::kTrue), check1,
+                                   if_not_smi);
+
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch1);
+  Node* etrue = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForSimd128Lane(
+          lane, lane_count, lane_type, lane_machine_type)),
+      value, value_map, if_true);
+  Node* vtrue = etrue;
+
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch1);
+  if_false = graph()->NewNode(common()->Merge(2), if_smi, if_false);
+  Node* efalse =
+      graph()->NewNode(common()->EffectPhi(2), effect, value_map, if_false);
+  Node* vfalse = graph()->CloneNode(node);
+  NodeProperties::ReplaceEffectInput(vfalse, efalse);
+  NodeProperties::ReplaceControlInput(vfalse, if_false);
+  efalse = vfalse;
+
+  control = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  effect = graph()->NewNode(common()->EffectPhi(2), etrue, efalse, control);
+  value = graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                           vtrue, vfalse, control);
+  ReplaceWithValue(node, value, effect, control);
+  return Replace(value);
+}
+
+
 Reduction JSIntrinsicLowering::ReduceSubString(Node* node) {
   return Change(node, CodeFactory::SubString(isolate()), 3);
 }
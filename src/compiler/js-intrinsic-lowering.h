@@ -38,6 +38,8 @@ class JSIntrinsicLowering final : public AdvancedReducer {
   Reduction Reduce(Node* node) final;
 
  private:
+  Reduction ReduceAtomicsIsLockFree(Node* node);
+  Reduction ReduceAtomicsLoad(Node* node);
   Reduction ReduceConstructDouble(Node* node);
   Reduction ReduceCreateIterResultObject(Node* node);
   Reduction ReduceDateField(Node* node);
@@ -58,6 +60,9 @@ class JSIntrinsicLowering final : public AdvancedReducer {
   Reduction ReduceFixedArrayGet(Node* node);
   Reduction ReduceFixedArraySet(Node* node);
   Reduction ReduceRegExpConstructResult(Node* node);
+  Reduction ReduceSimd128ExtractLane(Node* node, Handle<Map> map,
+                                     int lane_count, Type* lane_type,
+                                     MachineType lane_machine_type);
   Reduction ReduceRegExpExec(Node* node);
   Reduction ReduceRegExpFlags(Node* node);
   Reduction ReduceRegExpSource(Node* node);
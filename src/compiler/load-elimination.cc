@@ -11,6 +11,16 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
+namespace {
+
+// Maximum number of nested diamonds that are looked through when searching
+// for the value of a field. This bounds the cost of the search, which is
+// exponential in the depth.
+const int kMaxMergeDepth = 4;
+
+}  // namespace
+
+
 LoadElimination::~LoadElimination() {}
 
 
@@ -29,27 +39,32 @@ Reduction LoadElimination::ReduceLoadField(Node* node) {
   DCHECK_EQ(IrOpcode::kLoadField, node->opcode());
   FieldAccess const access = FieldAccessOf(node->op());
   Node* object = NodeProperties::GetValueInput(node, 0);
-  for (Node* effect = NodeProperties::GetEffectInput(node);;
-       effect = NodeProperties::GetEffectInput(effect)) {
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* value = LookupField(object, access, effect, kMaxMergeDepth);
+  if (value == nullptr) return NoChange();
+  ReplaceWithValue(node, value);
+  return Replace(value);
+}
+
+
+Node* LoadElimination::LookupField(Node* object, FieldAccess const& access,
+                                   Node* effect, int depth) {
+  for (;; effect = NodeProperties::GetEffectInput(effect)) {
     switch (effect->opcode()) {
       case IrOpcode::kLoadField: {
         if (object == NodeProperties::GetValueInput(effect, 0) &&
             access == FieldAccessOf(effect->op())) {
-          Node* const value = effect;
-          ReplaceWithValue(node, value);
-          return Replace(value);
+          return effect;
         }
         break;
       }
       case IrOpcode::kStoreField: {
         if (access == FieldAccessOf(effect->op())) {
           if (object == NodeProperties::GetValueInput(effect, 0)) {
-            Node* const value = NodeProperties::GetValueInput(effect, 1);
-            ReplaceWithValue(node, value);
-            return Replace(value);
+            return NodeProperties::GetValueInput(effect, 1);
           }
           // TODO(turbofan): Alias analysis to the rescue?
-          return NoChange();
+          return nullptr;
         }
         break;
       }
@@ -68,20 +83,40 @@ Reduction LoadElimination::ReduceLoadField(Node* node) {
       case IrOpcode::kAllocate: {
         // Allocations don't interfere with field loads. In case we see the
         // actual allocation for the {object} we can abort.
-        if (object == effect) return NoChange();
+        if (object == effect) return nullptr;
         break;
       }
+      case IrOpcode::kEffectPhi: {
+        // Look through diamonds (but not loops), which is where repeated map
+        // checks on the same object usually end up, i.e. after a polymorphic
+        // property access. The value is known if all inputs agree on it,
+        // which then also dominates the merge.
+        Node* const control = NodeProperties::GetControlInput(effect);
+        if (control->opcode() != IrOpcode::kMerge || depth == 0) {
+          return nullptr;
+        }
+        Node* value = nullptr;
+        for (int i = 0; i < effect->op()->EffectInputCount(); ++i) {
+          Node* const input_value = LookupField(
+              object, access, NodeProperties::GetEffectInput(effect, i),
+              depth - 1);
+          if (input_value == nullptr) return nullptr;
+          if (value != nullptr && value != input_value) return nullptr;
+          value = input_value;
+        }
+        return value;
+      }
       default: {
         if (!effect->op()->HasProperty(Operator::kNoWrite) ||
             effect->op()->EffectInputCount() != 1) {
-          return NoChange();
+          return nullptr;
         }
         break;
       }
     }
   }
   UNREACHABLE();
-  return NoChange();
+  return nullptr;
 }
 
 }  // namespace compiler
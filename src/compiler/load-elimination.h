@@ -11,6 +11,10 @@ namespace v8 {
 namespace internal {
 namespace compiler {
 
+// Forward declarations.
+struct FieldAccess;
+
+
 class LoadElimination final : public AdvancedReducer {
  public:
   explicit LoadElimination(Editor* editor) : AdvancedReducer(editor) {}
@@ -20,6 +24,12 @@ class LoadElimination final : public AdvancedReducer {
 
  private:
   Reduction ReduceLoadField(Node* node);
+
+  // Returns the value of the field described by {access} of {object} at
+  // {effect}, or nullptr if it is unknown. Diamonds are looked through up to
+  // {depth} levels deep, if all paths agree on the value.
+  Node* LookupField(Node* object, FieldAccess const& access, Node* effect,
+                    int depth);
 };
 
 }  // namespace compiler
@@ -0,0 +1,164 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-invariant-code-motion.h"
+
+#include "src/compiler/node-properties.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+
+namespace {
+
+bool IsHoistableLoad(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kLoadField:
+    case IrOpcode::kLoadElement:
+    case IrOpcode::kCheckedLoad:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+// Returns true if {node} does not write to memory (as far as the loads in
+// the loop are concerned).
+bool IsReadOnlyEffect(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kEffectPhi:
+    case IrOpcode::kLoad:
+      return true;
+    default:
+      return IsHoistableLoad(node);
+  }
+}
+
+}  // namespace
+
+
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(Graph* graph, Zone* zone)
+    : graph_(graph), zone_(zone) {}
+
+
+void LoopInvariantCodeMotion::Run() {
+  LoopTree* loop_tree = LoopFinder::BuildLoopTree(graph_, zone_);
+  if (loop_tree == nullptr) return;
+  for (LoopTree::Loop* loop : loop_tree->outer_loops()) {
+    VisitLoop(loop_tree, loop);
+  }
+}
+
+
+void LoopInvariantCodeMotion::VisitLoop(LoopTree* loop_tree,
+                                        LoopTree::Loop* loop) {
+  // Visit inner loops first, so that loads hoisted out of an inner loop can
+  // be hoisted further out of the outer loop.
+  for (LoopTree::Loop* child : loop->children()) VisitLoop(loop_tree, child);
+  HoistLoads(loop_tree, loop);
+}
+
+
+void LoopInvariantCodeMotion::HoistLoads(LoopTree* loop_tree,
+                                         LoopTree::Loop* loop) {
+  Node* header = loop_tree->GetLoopControl(loop);
+  if (header->InputCount() != 2) return;
+
+  // Find the effect phi of the loop; give up if there is more than one.
+  Node* effect_phi = nullptr;
+  for (Node* node : loop_tree->HeaderNodes(loop)) {
+    if (node->opcode() == IrOpcode::kEffectPhi) {
+      if (effect_phi != nullptr) return;
+      effect_phi = node;
+    }
+  }
+  if (effect_phi == nullptr) return;
+
+  // Loads can only be hoisted if nothing in the loop writes to memory.
+  NodeVector loads(zone_);
+  for (Node* node : loop_tree->LoopNodes(loop)) {
+    if (node->op()->EffectOutputCount() == 0) continue;
+    if (!IsReadOnlyEffect(node)) return;
+    if (IsHoistableLoad(node)) loads.push_back(node);
+  }
+
+  // Hoisting a load may make other loads invariant, so iterate to fixpoint.
+  ZoneSet<Node*> hoisted(zone_);
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (Node* node : loads) {
+      if (hoisted.count(node) != 0) continue;
+      if (!CanHoistLoad(loop_tree, loop, header, node, hoisted)) continue;
+      TRACE("Hoisting #%d:%s out of loop #%d\n", node->id(),
+            node->op()->mnemonic(), header->id());
+
+      // Remove the load from the effect chain of the loop...
+      Node* effect = NodeProperties::GetEffectInput(node);
+      for (Edge edge : node->use_edges()) {
+        if (NodeProperties::IsEffectEdge(edge)) edge.UpdateTo(effect);
+      }
+
+      // ...and put it in front of the loop instead.
+      Node* entry_effect = effect_phi->InputAt(kAssumedLoopEntryIndex);
+      Node* entry_control = header->InputAt(kAssumedLoopEntryIndex);
+      NodeProperties::ReplaceEffectInput(node, entry_effect);
+      NodeProperties::ReplaceControlInput(node, entry_control);
+      effect_phi->ReplaceInput(kAssumedLoopEntryIndex, node);
+
+      hoisted.insert(node);
+      changed = true;
+    }
+  }
+}
+
+
+bool LoopInvariantCodeMotion::CanHoistLoad(LoopTree* loop_tree,
+                                           LoopTree::Loop* loop, Node* header,
+                                           Node* node,
+                                           ZoneSet<Node*> const& hoisted) {
+  // The load must be executed on every iteration, so there must be no branch
+  // (or merge) between the loop header and the load.
+  Node* control = NodeProperties::GetControlInput(node);
+  while (control != header) {
+    switch (control->opcode()) {
+      case IrOpcode::kIfTrue:
+      case IrOpcode::kIfFalse:
+      case IrOpcode::kIfSuccess:
+      case IrOpcode::kIfException:
+      case IrOpcode::kIfValue:
+      case IrOpcode::kIfDefault:
+      case IrOpcode::kMerge:
+      case IrOpcode::kLoop:
+        return false;
+      default:
+        break;
+    }
+    if (control->op()->ControlInputCount() != 1) return false;
+    control = NodeProperties::GetControlInput(control);
+  }
+
+  // All value inputs must be defined outside of the loop (or hoisted out of
+  // it already).
+  for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+    Node* input = node->InputAt(i);
+    if (loop_tree->Contains(loop, input) && hoisted.count(input) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
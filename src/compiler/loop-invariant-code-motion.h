@@ -0,0 +1,40 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+#define V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
+
+#include "src/compiler/loop-analysis.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Hoists loads out of loops that do not write to memory. A load is hoisted if
+// all of its value inputs are loop invariant and it is executed on every
+// iteration, i.e. there is no branch between the loop header and the load.
+// Pure nodes do not need to be handled here, since the scheduler already
+// hoists them out of loops.
+class LoopInvariantCodeMotion final {
+ public:
+  LoopInvariantCodeMotion(Graph* graph, Zone* zone);
+
+  void Run();
+
+ private:
+  void VisitLoop(LoopTree* loop_tree, LoopTree::Loop* loop);
+  void HoistLoads(LoopTree* loop_tree, LoopTree::Loop* loop);
+
+  bool CanHoistLoad(LoopTree* loop_tree, LoopTree::Loop* loop, Node* header,
+                    Node* node, ZoneSet<Node*> const& hoisted);
+
+  Graph* const graph_;
+  Zone* const zone_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_INVARIANT_CODE_MOTION_H_
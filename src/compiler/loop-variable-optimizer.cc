@@ -0,0 +1,417 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-variable-optimizer.h"
+
+#include <algorithm>
+
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/loop-analysis.h"
+#include "src/compiler/node.h"
+#include "src/compiler/node-marker.h"
+#include "src/compiler/node-properties.h"
+#include "src/type-cache.h"
+#include "src/types-inl.h"
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+// Macro for outputting trace information from the loop variable optimizer.
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+static const int kFirstBackedge = 1;
+
+
+LoopVariableOptimizer::LoopVariableOptimizer(Graph* graph,
+                                             CommonOperatorBuilder* common,
+                                             Zone* zone)
+    : graph_(graph),
+      common_(common),
+      zone_(zone),
+      limits_(graph->NodeCount(), nullptr, zone),
+      induction_vars_(zone),
+      guard_sites_(zone) {}
+
+
+void LoopVariableOptimizer::Run() {
+  ZoneQueue<Node*> queue(zone());
+  NodeMarker<bool> queued(graph(), 2);
+  queue.push(graph()->start());
+  queued.Set(graph()->start(), true);
+  while (!queue.empty()) {
+    Node* node = queue.front();
+    queue.pop();
+    queued.Set(node, false);
+
+    DCHECK_NULL(GetLimits(node));
+    bool all_inputs_visited = true;
+    int inputs_end = (node->opcode() == IrOpcode::kLoop)
+                         ? kFirstBackedge
+                         : node->op()->ControlInputCount();
+    for (int i = 0; i < inputs_end; i++) {
+      if (GetLimits(NodeProperties::GetControlInput(node, i)) == nullptr) {
+        all_inputs_visited = false;
+        break;
+      }
+    }
+    if (!all_inputs_visited) continue;
+
+    VisitNode(node);
+    DCHECK_NOT_NULL(GetLimits(node));
+
+    // Queue control outputs.
+    for (Edge edge : node->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsControlEdge(edge) ||
+          use->op()->ControlOutputCount() == 0) {
+        continue;
+      }
+      if (use->opcode() == IrOpcode::kLoop &&
+          edge.index() != kAssumedLoopEntryIndex) {
+        VisitBackedge(node, use);
+      } else if (!queued.Get(use)) {
+        queue.push(use);
+        queued.Set(use, true);
+      }
+    }
+  }
+}
+
+
+void LoopVariableOptimizer::InsertGuards() {
+  TypeCache const& cache = TypeCache::Get();
+  for (GuardSite const& site : guard_sites_) {
+    const Constraint* constraint = site.constraint;
+    bool is_upper_bound = GetInductionVariable(constraint->left) != nullptr;
+    Node* phi = is_upper_bound ? constraint->left : constraint->right;
+    Node* bound = is_upper_bound ? constraint->right : constraint->left;
+    if (!NodeProperties::IsTyped(phi) || !NodeProperties::IsTyped(bound)) {
+      continue;
+    }
+
+    // The comparison only tells us something if both sides are integers.
+    Type* phi_type = NodeProperties::GetType(phi);
+    Type* bound_type = NodeProperties::GetType(bound);
+    if (!phi_type->IsInhabited() || !phi_type->Is(cache.kInteger) ||
+        !bound_type->IsInhabited() || !bound_type->Is(cache.kInteger)) {
+      continue;
+    }
+    double min = phi_type->Min();
+    double max = phi_type->Max();
+    double adjust = constraint->kind == InductionVariable::kStrict ? 1 : 0;
+    if (is_upper_bound) {
+      max = std::min(max, bound_type->Max() - adjust);
+    } else {
+      min = std::max(min, bound_type->Min() + adjust);
+    }
+    // Skip checks that do not narrow the type, and checks that can never
+    // succeed (the code they guard is dead anyway).
+    if (min > max || (min == phi_type->Min() && max == phi_type->Max())) {
+      continue;
+    }
+
+    // Collect the uses that are dominated by the check. Phis are skipped,
+    // because their inputs belong to the predecessors of the merge, and so
+    // are uses without a control input, as we cannot tell where they live.
+    NodeVector uses(zone());
+    for (Edge edge : phi->use_edges()) {
+      Node* use = edge.from();
+      if (!NodeProperties::IsValueEdge(edge) ||
+          use->opcode() == IrOpcode::kPhi ||
+          use->op()->ControlInputCount() == 0) {
+        continue;
+      }
+      const VariableLimits* limits =
+          GetLimits(NodeProperties::GetControlInput(use));
+      if (limits != nullptr && limits->Contains(constraint)) {
+        uses.push_back(use);
+      }
+    }
+    if (uses.empty()) continue;
+
+    Type* guard_type = Type::Range(min, max, graph()->zone());
+    Node* guard =
+        graph()->NewNode(common()->Guard(guard_type), phi, site.control);
+    TRACE("Guarding induction variable #%d with #%d:Guard at #%d:%s\n",
+          phi->id(), guard->id(), site.control->id(),
+          site.control->op()->mnemonic());
+    for (Node* use : uses) {
+      for (int i = 0; i < use->op()->ValueInputCount(); ++i) {
+        if (use->InputAt(i) == phi) use->ReplaceInput(i, guard);
+      }
+    }
+  }
+}
+
+
+InductionVariable* LoopVariableOptimizer::GetInductionVariable(
+    Node* phi) const {
+  auto it = induction_vars_.find(phi->id());
+  return it == induction_vars_.end() ? nullptr : it->second;
+}
+
+
+void LoopVariableOptimizer::VisitNode(Node* node) {
+  switch (node->opcode()) {
+    case IrOpcode::kMerge:
+      return VisitMerge(node);
+    case IrOpcode::kLoop:
+      return VisitLoop(node);
+    case IrOpcode::kIfFalse:
+      return VisitIf(node, false);
+    case IrOpcode::kIfTrue:
+      return VisitIf(node, true);
+    case IrOpcode::kStart:
+      return VisitStart(node);
+    default:
+      return VisitOtherControl(node);
+  }
+}
+
+
+void LoopVariableOptimizer::VisitBackedge(Node* from, Node* loop) {
+  if (loop->op()->ControlInputCount() != 2) return;
+
+  // Go through the constraints that hold on the backedge, and record those
+  // that mention an induction variable of this loop as its bounds.
+  for (const Constraint* constraint = GetLimits(from)->head();
+       constraint != nullptr; constraint = constraint->next) {
+    InductionVariable* var = GetInductionVariable(constraint->left);
+    if (var != nullptr &&
+        NodeProperties::GetControlInput(var->phi()) == loop) {
+      var->AddUpperBound(constraint->right, constraint->kind);
+    }
+    var = GetInductionVariable(constraint->right);
+    if (var != nullptr &&
+        NodeProperties::GetControlInput(var->phi()) == loop) {
+      var->AddLowerBound(constraint->left, constraint->kind);
+    }
+  }
+}
+
+
+void LoopVariableOptimizer::VisitMerge(Node* node) {
+  // Merge the limits of all incoming edges.
+  VariableLimits* merged = GetLimits(node->InputAt(0))->Copy(zone());
+  for (int i = 1; i < node->InputCount(); i++) {
+    merged->Merge(GetLimits(node->InputAt(i)));
+  }
+  SetLimits(node, merged);
+}
+
+
+void LoopVariableOptimizer::VisitLoop(Node* node) {
+  DetectInductionVariables(node);
+  // Conservatively take the limits from the loop entry here.
+  return TakeConditionsFromFirstControl(node);
+}
+
+
+void LoopVariableOptimizer::VisitIf(Node* node, bool polarity) {
+  Node* branch = node->InputAt(0);
+  Node* cond = branch->InputAt(0);
+  VariableLimits* limits = GetLimits(branch)->Copy(zone());
+  // Normalize to less than comparison.
+  switch (cond->opcode()) {
+    case IrOpcode::kJSLessThan:
+    case IrOpcode::kNumberLessThan:
+      AddCmpToLimits(limits, cond, InductionVariable::kStrict, polarity);
+      break;
+    case IrOpcode::kJSGreaterThan:
+      AddCmpToLimits(limits, cond, InductionVariable::kNonStrict, !polarity);
+      break;
+    case IrOpcode::kJSLessThanOrEqual:
+    case IrOpcode::kNumberLessThanOrEqual:
+      AddCmpToLimits(limits, cond, InductionVariable::kNonStrict, polarity);
+      break;
+    case IrOpcode::kJSGreaterThanOrEqual:
+      AddCmpToLimits(limits, cond, InductionVariable::kStrict, !polarity);
+      break;
+    default:
+      break;
+  }
+  SetLimits(node, limits);
+  if (limits->head() != GetLimits(branch)->head()) {
+    guard_sites_.push_back(GuardSite(node, limits->head()));
+  }
+}
+
+
+void LoopVariableOptimizer::AddCmpToLimits(
+    VariableLimits* limits, Node* node, InductionVariable::ConstraintKind kind,
+    bool polarity) {
+  Node* left = node->InputAt(0);
+  Node* right = node->InputAt(1);
+  // Only keep track of comparisons that mention an induction variable.
+  if (GetInductionVariable(left) == nullptr &&
+      GetInductionVariable(right) == nullptr) {
+    return;
+  }
+  // The negation of a comparison is only meaningful if neither side can be
+  // NaN; the users of the constraints make sure that both sides are
+  // integers.
+  if (polarity) {
+    limits->Add(left, kind, right, zone());
+  } else {
+    kind = (kind == InductionVariable::kStrict)
+               ? InductionVariable::kNonStrict
+               : InductionVariable::kStrict;
+    limits->Add(right, kind, left, zone());
+  }
+}
+
+
+void LoopVariableOptimizer::VisitStart(Node* node) {
+  SetLimits(node, VariableLimits::Empty(zone()));
+}
+
+
+void LoopVariableOptimizer::VisitOtherControl(Node* node) {
+  DCHECK_EQ(1, node->op()->ControlInputCount());
+  return TakeConditionsFromFirstControl(node);
+}
+
+
+void LoopVariableOptimizer::TakeConditionsFromFirstControl(Node* node) {
+  SetLimits(node, GetLimits(NodeProperties::GetControlInput(node, 0)));
+}
+
+
+void LoopVariableOptimizer::DetectInductionVariables(Node* loop) {
+  if (loop->op()->ControlInputCount() != 2) return;
+  TRACE("Loop variables for loop %i:", loop->id());
+  for (Edge edge : loop->use_edges()) {
+    if (NodeProperties::IsControlEdge(edge) &&
+        edge.from()->opcode() == IrOpcode::kPhi) {
+      Node* phi = edge.from();
+      InductionVariable* induction_var = TryGetInductionVariable(phi);
+      if (induction_var) {
+        induction_vars_[phi->id()] = induction_var;
+        TRACE(" %i", induction_var->phi()->id());
+      }
+    }
+  }
+  TRACE("\n");
+}
+
+
+InductionVariable* LoopVariableOptimizer::TryGetInductionVariable(Node* phi) {
+  DCHECK_EQ(2, phi->op()->ValueInputCount());
+  DCHECK_EQ(IrOpcode::kLoop, NodeProperties::GetControlInput(phi)->opcode());
+  Node* arith = phi->InputAt(1);
+  InductionVariable::ArithmeticType arithmetic_type;
+  switch (arith->opcode()) {
+    case IrOpcode::kJSAdd:
+    case IrOpcode::kNumberAdd:
+      arithmetic_type = InductionVariable::kAddition;
+      break;
+    case IrOpcode::kJSSubtract:
+    case IrOpcode::kNumberSubtract:
+      arithmetic_type = InductionVariable::kSubtraction;
+      break;
+    default:
+      return nullptr;
+  }
+
+  // Count operations convert the old value to a number first.
+  Node* input = arith->InputAt(0);
+  if (input->opcode() == IrOpcode::kJSToNumber) {
+    input = input->InputAt(0);
+  }
+  if (input != phi) return nullptr;
+
+  Node* initial = phi->InputAt(0);
+  Node* increment = arith->InputAt(1);
+  return new (zone()) InductionVariable(phi, arith, increment, initial,
+                                        arithmetic_type, zone());
+}
+
+
+const LoopVariableOptimizer::VariableLimits* LoopVariableOptimizer::GetLimits(
+    Node* node) const {
+  size_t index = static_cast<size_t>(node->id());
+  return index < limits_.size() ? limits_[index] : nullptr;
+}
+
+
+void LoopVariableOptimizer::SetLimits(Node* node,
+                                      const VariableLimits* limits) {
+  size_t index = static_cast<size_t>(node->id());
+  if (index >= limits_.size()) limits_.resize(index + 1, nullptr);
+  limits_[index] = limits;
+}
+
+
+// static
+LoopVariableOptimizer::VariableLimits*
+LoopVariableOptimizer::VariableLimits::Empty(Zone* zone) {
+  return new (zone) VariableLimits(nullptr, 0);
+}
+
+
+LoopVariableOptimizer::VariableLimits*
+LoopVariableOptimizer::VariableLimits::Copy(Zone* zone) const {
+  return new (zone) VariableLimits(head_, count_);
+}
+
+
+void LoopVariableOptimizer::VariableLimits::Add(
+    Node* left, InductionVariable::ConstraintKind kind, Node* right,
+    Zone* zone) {
+  head_ = new (zone->New(sizeof(Constraint)))
+      Constraint(left, kind, right, head_);
+  count_++;
+}
+
+
+void LoopVariableOptimizer::VariableLimits::Merge(
+    const VariableLimits* other) {
+  // Change the current constraint list to the longest common tail of this
+  // list and the other list (the common tail corresponds to the constraints
+  // of the common dominator).
+
+  // First, we throw away the prefix of the longer list, so that
+  // we have lists of the same length.
+  size_t other_size = other->count_;
+  const Constraint* other_constraint = other->head_;
+  while (other_size > count_) {
+    other_constraint = other_constraint->next;
+    other_size--;
+  }
+  while (count_ > other_size) {
+    head_ = head_->next;
+    count_--;
+  }
+
+  // Then we go through both lists in lock-step until we find
+  // the common tail.
+  while (head_ != other_constraint) {
+    DCHECK_LT(0u, count_);
+    count_--;
+    other_constraint = other_constraint->next;
+    head_ = head_->next;
+  }
+}
+
+
+bool LoopVariableOptimizer::VariableLimits::Contains(
+    const Constraint* constraint) const {
+  for (const Constraint* current = head_; current != nullptr;
+       current = current->next) {
+    if (current == constraint) return true;
+  }
+  return false;
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
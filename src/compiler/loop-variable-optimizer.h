@@ -0,0 +1,174 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
+#define V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
+
+#include "src/zone-containers.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class CommonOperatorBuilder;
+class Graph;
+class Node;
+
+
+// Describes a loop phi that is incremented (or decremented) by some amount
+// on every iteration, together with the bounds that are checked against the
+// phi on every path from the loop header to the backedge.
+class InductionVariable : public ZoneObject {
+ public:
+  enum ConstraintKind { kStrict, kNonStrict };
+  enum ArithmeticType { kAddition, kSubtraction };
+
+  struct Bound {
+    Bound(Node* bound, ConstraintKind kind) : bound(bound), kind(kind) {}
+
+    Node* bound;
+    ConstraintKind kind;
+  };
+
+  Node* phi() const { return phi_; }
+  Node* arith() const { return arith_; }
+  Node* increment() const { return increment_; }
+  Node* init_value() const { return init_value_; }
+  ArithmeticType arithmetic_type() const { return arithmetic_type_; }
+
+  const ZoneVector<Bound>& lower_bounds() const { return lower_bounds_; }
+  const ZoneVector<Bound>& upper_bounds() const { return upper_bounds_; }
+
+ private:
+  friend class LoopVariableOptimizer;
+
+  InductionVariable(Node* phi, Node* arith, Node* increment, Node* init_value,
+                    ArithmeticType arithmetic_type, Zone* zone)
+      : phi_(phi),
+        arith_(arith),
+        increment_(increment),
+        init_value_(init_value),
+        arithmetic_type_(arithmetic_type),
+        lower_bounds_(zone),
+        upper_bounds_(zone) {}
+
+  void AddUpperBound(Node* bound, ConstraintKind kind) {
+    upper_bounds_.push_back(Bound(bound, kind));
+  }
+  void AddLowerBound(Node* bound, ConstraintKind kind) {
+    lower_bounds_.push_back(Bound(bound, kind));
+  }
+
+  Node* phi_;
+  Node* arith_;
+  Node* increment_;
+  Node* init_value_;
+  ArithmeticType arithmetic_type_;
+  ZoneVector<Bound> lower_bounds_;
+  ZoneVector<Bound> upper_bounds_;
+};
+
+
+// Finds the induction variables of all loops in the graph. The typer uses
+// them to compute precise ranges for loop phis, which would otherwise have
+// to be widened. Once the graph is typed, {InsertGuards} narrows the type of
+// induction variable uses that are dominated by a bounds check, so that the
+// check can be dropped from element accesses that are provably in bounds.
+class LoopVariableOptimizer {
+ public:
+  LoopVariableOptimizer(Graph* graph, CommonOperatorBuilder* common,
+                        Zone* zone);
+
+  void Run();
+  void InsertGuards();
+
+  // Returns the induction variable for {phi}, or nullptr if {phi} is not an
+  // induction variable.
+  InductionVariable* GetInductionVariable(Node* phi) const;
+
+  const ZoneMap<int, InductionVariable*>& induction_variables() const {
+    return induction_vars_;
+  }
+
+ private:
+  // A constraint "left < right" or "left <= right" that holds on some
+  // control path.
+  struct Constraint {
+    Constraint(Node* left, InductionVariable::ConstraintKind kind,
+               Node* right, const Constraint* next)
+        : left(left), kind(kind), right(right), next(next) {}
+
+    Node* left;
+    InductionVariable::ConstraintKind kind;
+    Node* right;
+    const Constraint* next;
+  };
+
+  // The list of constraints that hold at a control node. The lists of
+  // dominated control nodes share their tail with the list of the dominator,
+  // so merging two lists amounts to finding their longest common tail.
+  class VariableLimits : public ZoneObject {
+   public:
+    static VariableLimits* Empty(Zone* zone);
+    VariableLimits* Copy(Zone* zone) const;
+    void Add(Node* left, InductionVariable::ConstraintKind kind, Node* right,
+             Zone* zone);
+    void Merge(const VariableLimits* other);
+    bool Contains(const Constraint* constraint) const;
+
+    const Constraint* head() const { return head_; }
+
+   private:
+    VariableLimits(const Constraint* head, size_t count)
+        : head_(head), count_(count) {}
+
+    const Constraint* head_;
+    // We keep track of the list length so that we can find the longest
+    // common tail easily.
+    size_t count_;
+  };
+
+  // A control node that establishes a constraint on an induction variable.
+  struct GuardSite {
+    GuardSite(Node* control, const Constraint* constraint)
+        : control(control), constraint(constraint) {}
+
+    Node* control;
+    const Constraint* constraint;
+  };
+
+  void VisitNode(Node* node);
+  void VisitBackedge(Node* from, Node* loop);
+  void VisitIf(Node* node, bool polarity);
+  void VisitMerge(Node* node);
+  void VisitLoop(Node* node);
+  void VisitStart(Node* node);
+  void VisitOtherControl(Node* node);
+  void TakeConditionsFromFirstControl(Node* node);
+
+  void AddCmpToLimits(VariableLimits* limits, Node* node,
+                      InductionVariable::ConstraintKind kind, bool polarity);
+  void DetectInductionVariables(Node* loop);
+  InductionVariable* TryGetInductionVariable(Node* phi);
+
+  const VariableLimits* GetLimits(Node* node) const;
+  void SetLimits(Node* node, const VariableLimits* limits);
+
+  Graph* graph() const { return graph_; }
+  CommonOperatorBuilder* common() const { return common_; }
+  Zone* zone() const { return zone_; }
+
+  Graph* const graph_;
+  CommonOperatorBuilder* const common_;
+  Zone* const zone_;
+  ZoneVector<const VariableLimits*> limits_;
+  ZoneMap<int, InductionVariable*> induction_vars_;
+  ZoneVector<GuardSite> guard_sites_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VARIABLE_OPTIMIZER_H_
@@ -69,7 +69,8 @@ std::ostream& operator<<(std::ostream& os, StoreRepresentation rep) {
 
 
 LoadRepresentation LoadRepresentationOf(Operator const* op) {
-  DCHECK_EQ(IrOpcode::kLoad, op->opcode());
+  DCHECK(op->opcode() == IrOpcode::kLoad ||
+         op->opcode() == IrOpcode::kAtomicLoad);
   return OpParameter<LoadRepresentation>(op);
 }
 
@@ -274,8 +275,16 @@ struct MachineOperatorGlobalCache {
               IrOpcode::kCheckedLoad, Operator::kNoThrow | Operator::kNoWrite, \
               "CheckedLoad", 3, 1, 1, 1, 1, 0, MachineType::Type()) {}         \
   };                                                                           \
+  struct AtomicLoad##Type##Operator final                                      \
+      : public Operator1<LoadRepresentation> {                                 \
+    AtomicLoad##Type##Operator()                                               \
+        : Operator1<LoadRepresentation>(                                       \
+              IrOpcode::kAtomicLoad, Operator::kNoThrow, "AtomicLoad", 2, 1,   \
+              1, 1, 1, 0, MachineType::Type()) {}                              \
+  };                                                                           \
   Load##Type##Operator kLoad##Type;                                            \
-  CheckedLoad##Type##Operator kCheckedLoad##Type;
+  CheckedLoad##Type##Operator kCheckedLoad##Type;                              \
+  AtomicLoad##Type##Operator kAtomicLoad##Type;
   MACHINE_TYPE_LIST(LOAD)
 #undef LOAD
 
@@ -406,6 +415,21 @@ const Operator* MachineOperatorBuilder::Store(StoreRepresentation store_rep) {
 }
 
 
+const OptionalOperator MachineOperatorBuilder::AtomicLoad(
+    LoadRepresentation rep) {
+  if (flags_ & kAtomicLoad) {
+#define LOAD(Type)                                      \
+  if (rep == MachineType::Type()) {                     \
+    return OptionalOperator(&cache_.kAtomicLoad##Type); \
+  }
+    MACHINE_TYPE_LIST(LOAD)
+#undef LOAD
+    UNREACHABLE();
+  }
+  return OptionalOperator(nullptr);
+}
+
+
 const Operator* MachineOperatorBuilder::CheckedLoad(
     CheckedLoadRepresentation rep) {
 #define LOAD(Type)                     \
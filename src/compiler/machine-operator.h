@@ -134,12 +134,14 @@ class MachineOperatorBuilder final : public ZoneObject {
     kWord64Ctz = 1u << 17,
     kWord32Popcnt = 1u << 18,
     kWord64Popcnt = 1u << 19,
+    kAtomicLoad = 1u << 20,
     kAllOptionalOps = kFloat32Max | kFloat32Min | kFloat64Max | kFloat64Min |
                       kFloat32RoundDown | kFloat64RoundDown | kFloat32RoundUp |
                       kFloat64RoundUp | kFloat32RoundTruncate |
                       kFloat64RoundTruncate | kFloat64RoundTiesAway |
                       kFloat32RoundTiesEven | kFloat64RoundTiesEven |
-                      kWord32Ctz | kWord64Ctz | kWord32Popcnt | kWord64Popcnt
+                      kWord32Ctz | kWord64Ctz | kWord32Popcnt | kWord64Popcnt |
+                      kAtomicLoad
   };
   typedef base::Flags<Flag, unsigned> Flags;
 
@@ -307,6 +309,9 @@ class MachineOperatorBuilder final : public ZoneObject {
   const Operator* LoadStackPointer();
   const Operator* LoadFramePointer();
 
+  // atomic-load [base + index], sequentially consistent
+  const OptionalOperator AtomicLoad(LoadRepresentation rep);
+
   // checked-load heap, index, length
   const Operator* CheckedLoad(CheckedLoadRepresentation);
   // checked-store heap, index, length, value
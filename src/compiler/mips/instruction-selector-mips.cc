@@ -936,6 +936,9 @@ void InstructionSelector::VisitCheckedStore(Node* node) {
 }
 
 
+void InstructionSelector::VisitAtomicLoad(Node* node) { UNREACHABLE(); }
+
+
 namespace {
 
 // Shared routine for multiple compare operations.
@@ -19,6 +19,7 @@
 #include "src/compiler/common-operator-reducer.h"
 #include "src/compiler/control-flow-optimizer.h"
 #include "src/compiler/dead-code-elimination.h"
+#include "src/compiler/dead-store-elimination.h"
 #include "src/compiler/escape-analysis.h"
 #include "src/compiler/escape-analysis-reducer.h"
 #include "src/compiler/frame-elider.h"
@@ -43,7 +44,9 @@
 #include "src/compiler/live-range-separator.h"
 #include "src/compiler/load-elimination.h"
 #include "src/compiler/loop-analysis.h"
+#include "src/compiler/loop-invariant-code-motion.h"
 #include "src/compiler/loop-peeling.h"
+#include "src/compiler/loop-variable-optimizer.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/move-optimizer.h"
 #include "src/compiler/osr.h"
@@ -585,7 +588,11 @@ struct TyperPhase {
   void Run(PipelineData* data, Zone* temp_zone, Typer* typer) {
     NodeVector roots(temp_zone);
     data->jsgraph()->GetCachedNodes(&roots);
-    typer->Run(roots);
+    LoopVariableOptimizer induction_vars(data->jsgraph()->graph(),
+                                         data->common(), temp_zone);
+    if (FLAG_turbo_loop_variable) induction_vars.Run();
+    typer->Run(roots, &induction_vars);
+    if (FLAG_turbo_loop_variable) induction_vars.InsertGuards();
   }
 };
 
@@ -653,6 +660,28 @@ struct BranchEliminationPhase {
 };
 
 
+struct StoreEliminationPhase {
+  static const char* phase_name() { return "store elimination"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    JSGraphReducer graph_reducer(data->jsgraph(), temp_zone);
+    DeadStoreElimination dead_store_elimination(&graph_reducer);
+    AddReducer(data, &graph_reducer, &dead_store_elimination);
+    graph_reducer.ReduceGraph();
+  }
+};
+
+
+struct LoopInvariantCodeMotionPhase {
+  static const char* phase_name() { return "loop invariant code motion"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    LoopInvariantCodeMotion licm(data->graph(), temp_zone);
+    licm.Run();
+  }
+};
+
+
 struct EscapeAnalysisPhase {
   static const char* phase_name() { return "escape analysis"; }
 
@@ -1178,6 +1207,18 @@ Handle<Code> Pipeline::GenerateCode() {
     Run<BranchEliminationPhase>();
     RunPrintAndVerify("Branch conditions eliminated");
 
+    if (FLAG_turbo_store_elimination) {
+      // Run after branch elimination, which removes deoptimization points
+      // that would otherwise observe the dead stores.
+      Run<StoreEliminationPhase>();
+      RunPrintAndVerify("Dead stores eliminated");
+    }
+
+    if (FLAG_turbo_licm) {
+      Run<LoopInvariantCodeMotionPhase>();
+      RunPrintAndVerify("Loop invariant code moved");
+    }
+
     // Optimize control flow.
     if (FLAG_turbo_cf_optimization) {
       Run<ControlFlowOptimizationPhase>();
@@ -1392,6 +1433,20 @@ Handle<Code> Pipeline::ScheduleAndGenerateCode(
 }
 
 
+bool Pipeline::UseGreedyAllocator(bool is_optimizing,
+                                  size_t instruction_count) {
+  if (FLAG_turbo_greedy_regalloc) return true;
+  if (!FLAG_turbo_adaptive_regalloc) return false;
+  // The greedy allocator produces better code than linear scan, but takes
+  // longer, which doesn't pay off for huge functions. Optimized functions are
+  // hot by definition, so use it for those unless they are too big; stubs
+  // keep using linear scan.
+  if (!is_optimizing) return false;
+  return instruction_count <=
+         static_cast<size_t>(FLAG_turbo_greedy_regalloc_max_size);
+}
+
+
 void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
                                  CallDescriptor* descriptor,
                                  bool run_verifier) {
@@ -1436,7 +1491,8 @@ void Pipeline::AllocateRegisters(const RegisterConfiguration* config,
     Run<SplinterLiveRangesPhase>();
   }
 
-  if (FLAG_turbo_greedy_regalloc) {
+  if (UseGreedyAllocator(info()->IsOptimizing(),
+                         data->sequence()->instructions().size())) {
     Run<AllocateGeneralRegistersPhase<GreedyAllocator>>();
     Run<AllocateDoubleRegistersPhase<GreedyAllocator>>();
   } else {
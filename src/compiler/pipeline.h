@@ -49,6 +49,10 @@ class Pipeline {
                                           InstructionSequence* sequence,
                                           bool run_verifier);
 
+  // Returns whether the register allocator for a function with
+  // {instruction_count} instructions is the greedy one, or linear scan.
+  static bool UseGreedyAllocator(bool is_optimizing, size_t instruction_count);
+
   // Run the pipeline on a machine graph and generate code. If {schedule} is
   // {nullptr}, then compute a new schedule for code generation.
   static Handle<Code> GenerateCodeForTesting(CompilationInfo* info,
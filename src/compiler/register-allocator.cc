@@ -1283,7 +1283,6 @@ RegisterAllocationData::RegisterAllocationData(
       allocatable_double_codes_(this->config()->num_double_registers(), -1,
                                 allocation_zone()),
       live_in_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
-      live_out_sets_(code->InstructionBlockCount(), nullptr, allocation_zone()),
       live_ranges_(code->VirtualRegisterCount() * 2, nullptr,
                    allocation_zone()),
       fixed_live_ranges_(this->config()->num_general_registers(), nullptr,
@@ -1742,33 +1741,31 @@ LiveRangeBuilder::LiveRangeBuilder(RegisterAllocationData* data,
 
 BitVector* LiveRangeBuilder::ComputeLiveOut(const InstructionBlock* block,
                                             RegisterAllocationData* data) {
-  size_t block_index = block->rpo_number().ToSize();
-  BitVector* live_out = data->live_out_sets()[block_index];
-  if (live_out == nullptr) {
-    // Compute live out for the given block, except not including backward
-    // successor edges.
-    Zone* zone = data->allocation_zone();
-    const InstructionSequence* code = data->code();
-
-    live_out = new (zone) BitVector(code->VirtualRegisterCount(), zone);
-
-    // Process all successor blocks.
-    for (const RpoNumber& succ : block->successors()) {
-      // Add values live on entry to the successor.
-      if (succ <= block->rpo_number()) continue;
-      BitVector* live_in = data->live_in_sets()[succ.ToSize()];
-      if (live_in != nullptr) live_out->Union(*live_in);
-
-      // All phi input operands corresponding to this successor edge are live
-      // out from this block.
-      const InstructionBlock* successor = code->InstructionBlockAt(succ);
-      size_t index = successor->PredecessorIndexOf(block->rpo_number());
-      DCHECK(index < successor->PredecessorCount());
-      for (PhiInstruction* phi : successor->phis()) {
-        live_out->Add(phi->operands()[index]);
-      }
+  // Compute live out for the given block, except not including backward
+  // successor edges. This is called exactly once per block, and the result is
+  // turned into the live in set of the block afterwards, so there is no need
+  // to cache it separately.
+  Zone* zone = data->allocation_zone();
+  const InstructionSequence* code = data->code();
+
+  BitVector* live_out =
+      new (zone) BitVector(code->VirtualRegisterCount(), zone);
+
+  // Process all successor blocks.
+  for (const RpoNumber& succ : block->successors()) {
+    // Add values live on entry to the successor.
+    if (succ <= block->rpo_number()) continue;
+    BitVector* live_in = data->live_in_sets()[succ.ToSize()];
+    if (live_in != nullptr) live_out->Union(*live_in);
+
+    // All phi input operands corresponding to this successor edge are live
+    // out from this block.
+    const InstructionBlock* successor = code->InstructionBlockAt(succ);
+    size_t index = successor->PredecessorIndexOf(block->rpo_number());
+    DCHECK(index < successor->PredecessorCount());
+    for (PhiInstruction* phi : successor->phis()) {
+      live_out->Add(phi->operands()[index]);
     }
-    data->live_out_sets()[block_index] = live_out;
   }
   return live_out;
 }
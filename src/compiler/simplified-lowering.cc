@@ -623,6 +623,26 @@ class RepresentationSelector {
     }
   }
 
+  // Helper for handling guards. A guard on a number merely narrows the type
+  // of its input, so it takes the representation that a phi of that type
+  // would get, and is replaced by its input once its uses have been lowered.
+  void VisitGuard(Node* node, Truncation truncation) {
+    if (!NodeProperties::GetType(node->InputAt(0))->Is(Type::Number())) {
+      VisitInputs(node);
+      return SetOutput(node, MachineType::AnyTagged());
+    }
+    MachineRepresentation output = GetRepresentationForPhi(node, truncation);
+
+    Type* upper = NodeProperties::GetType(node);
+    MachineType output_type =
+        MachineType(output, changer_->TypeFromUpperBound(upper));
+    SetOutput(node, output_type);
+
+    ProcessInput(node, 0, UseInfo(output, truncation));
+    EnqueueInput(node, NodeProperties::FirstControlIndex(node));
+    if (lower()) DeferReplacement(node, node->InputAt(0));
+  }
+
   void VisitCall(Node* node, SimplifiedLowering* lowering) {
     const CallDescriptor* desc = OpParameter<const CallDescriptor*>(node->op());
     const MachineSignature* sig = desc->GetMachineSignature();
@@ -751,6 +771,8 @@ class RepresentationSelector {
         return VisitSelect(node, truncation, lowering);
       case IrOpcode::kPhi:
         return VisitPhi(node, truncation, lowering);
+      case IrOpcode::kGuard:
+        return VisitGuard(node, truncation);
       case IrOpcode::kCall:
         return VisitCall(node, lowering);
 
@@ -1100,6 +1122,14 @@ class RepresentationSelector {
         SetOutput(node, rep);
         break;
       }
+      case IrOpcode::kAtomicLoad: {
+        LoadRepresentation rep = LoadRepresentationOf(node->op());
+        ProcessInput(node, 0, UseInfo::PointerInt());  // raw pointer
+        ProcessInput(node, 1, UseInfo::PointerInt());  // index
+        ProcessRemainingInputs(node, 2);
+        SetOutput(node, rep);
+        break;
+      }
       case IrOpcode::kStore: {
         // TODO(jarin) Eventually, we should get rid of all machine stores
         // from the high-level phases, then this becomes UNREACHABLE.
@@ -10,6 +10,7 @@
 #include "src/compiler/common-operator.h"
 #include "src/compiler/graph-reducer.h"
 #include "src/compiler/js-operator.h"
+#include "src/compiler/loop-variable-optimizer.h"
 #include "src/compiler/node.h"
 #include "src/compiler/node-properties.h"
 #include "src/compiler/simplified-operator.h"
@@ -78,13 +79,17 @@ Typer::~Typer() {
 }
 
 
-class Typer::Visitor : public Reducer {
+class Typer::Visitor : public AdvancedReducer {
  public:
-  explicit Visitor(Typer* typer)
-      : typer_(typer), weakened_nodes_(typer->zone()) {}
+  Visitor(Editor* editor, Typer* typer, LoopVariableOptimizer* induction_vars)
+      : AdvancedReducer(editor),
+        typer_(typer),
+        induction_vars_(induction_vars),
+        weakened_nodes_(typer->zone()) {}
 
   Reduction Reduce(Node* node) override {
     if (node->op()->ValueOutputCount() == 0) return NoChange();
+    if (induction_vars_ != nullptr) RevisitInductionVariables(node);
     switch (node->opcode()) {
 #define DECLARE_CASE(x) \
   case IrOpcode::k##x:  \
@@ -180,6 +185,7 @@ class Typer::Visitor : public Reducer {
 
  private:
   Typer* typer_;
+  LoopVariableOptimizer* induction_vars_;
   ZoneSet<NodeId> weakened_nodes_;
 
 #define DECLARE_METHOD(x) inline Type* Type##x(Node* node);
@@ -188,6 +194,37 @@ class Typer::Visitor : public Reducer {
   VALUE_OP_LIST(DECLARE_METHOD)
 #undef DECLARE_METHOD
 
+  Type* TypeInductionVariablePhi(Node* node, InductionVariable* var);
+
+  // The type of an induction variable phi depends on the types of the
+  // increment and the bounds, which are not inputs of the phi. Revisit the
+  // phi whenever the comparison or the arithmetic operation that mentions it
+  // is typed, so that it picks up changes in those types.
+  void RevisitInductionVariables(Node* node) {
+    for (int i = 0; i < node->op()->ValueInputCount(); ++i) {
+      Node* const input = node->InputAt(i);
+      if (input->opcode() == IrOpcode::kPhi &&
+          induction_vars_->GetInductionVariable(input) != nullptr) {
+        Revisit(input);
+      }
+    }
+    switch (node->opcode()) {
+      case IrOpcode::kJSAdd:
+      case IrOpcode::kJSSubtract:
+      case IrOpcode::kNumberAdd:
+      case IrOpcode::kNumberSubtract:
+        for (Node* const use : node->uses()) {
+          if (use->opcode() == IrOpcode::kPhi &&
+              induction_vars_->GetInductionVariable(use) != nullptr) {
+            Revisit(use);
+          }
+        }
+        break;
+      default:
+        break;
+    }
+  }
+
   Type* TypeOrNone(Node* node) {
     return NodeProperties::IsTyped(node) ? NodeProperties::GetType(node)
                                          : Type::None();
@@ -290,11 +327,29 @@ class Typer::Visitor : public Reducer {
 void Typer::Run() { Run(NodeVector(zone())); }
 
 
-void Typer::Run(const NodeVector& roots) {
-  Visitor visitor(this);
+void Typer::Run(const NodeVector& roots) { Run(roots, nullptr); }
+
+
+void Typer::Run(const NodeVector& roots,
+                LoopVariableOptimizer* induction_vars) {
   GraphReducer graph_reducer(zone(), graph());
+  Visitor visitor(&graph_reducer, this, induction_vars);
   graph_reducer.AddReducer(&visitor);
   for (Node* const root : roots) graph_reducer.ReduceNode(root);
+  if (induction_vars != nullptr) {
+    // Type the increments and bounds of the induction variables before the
+    // phis, so that the phis do not have to be widened once they are known.
+    for (auto const& entry : induction_vars->induction_variables()) {
+      InductionVariable* const var = entry.second;
+      graph_reducer.ReduceNode(var->increment());
+      for (InductionVariable::Bound const& bound : var->upper_bounds()) {
+        graph_reducer.ReduceNode(bound.bound);
+      }
+      for (InductionVariable::Bound const& bound : var->lower_bounds()) {
+        graph_reducer.ReduceNode(bound.bound);
+      }
+    }
+  }
   graph_reducer.ReduceGraph();
 }
 
@@ -305,7 +360,7 @@ void Typer::Decorator::Decorate(Node* node) {
     // Other cases will generally require a proper fixpoint iteration with Run.
     bool is_typed = NodeProperties::IsTyped(node);
     if (is_typed || NodeProperties::AllValueInputsAreTyped(node)) {
-      Visitor typing(typer_);
+      Visitor typing(nullptr, typer_, nullptr);
       Type* type = typing.TypeNode(node);
       if (is_typed) {
         type = Type::Intersect(type, NodeProperties::GetType(node),
@@ -588,6 +643,10 @@ Type* Typer::Visitor::TypeSelect(Node* node) {
 
 
 Type* Typer::Visitor::TypePhi(Node* node) {
+  if (induction_vars_ != nullptr) {
+    InductionVariable* var = induction_vars_->GetInductionVariable(node);
+    if (var != nullptr) return TypeInductionVariablePhi(node, var);
+  }
   int arity = node->op()->ValueInputCount();
   Type* type = Operand(node, 0);
   for (int i = 1; i < arity; ++i) {
@@ -597,6 +656,82 @@ Type* Typer::Visitor::TypePhi(Node* node) {
 }
 
 
+Type* Typer::Visitor::TypeInductionVariablePhi(Node* node,
+                                               InductionVariable* var) {
+  DCHECK_EQ(2, node->op()->ValueInputCount());
+  Type* initial_type = Operand(node, 0);
+  Type* increment_type = TypeOrNone(var->increment());
+
+  // We only handle integer induction variables (otherwise ranges do not
+  // apply and we cannot do anything).
+  if (!initial_type->Is(typer_->cache_.kInteger) ||
+      !increment_type->Is(typer_->cache_.kInteger)) {
+    return Type::Union(initial_type, Operand(node, 1), zone());
+  }
+  // If we do not have enough type information for the initial value or the
+  // increment, just return the initial value's type.
+  if (!initial_type->IsInhabited() || !increment_type->IsInhabited() ||
+      increment_type->Is(typer_->cache_.kSingletonZero)) {
+    return initial_type;
+  }
+
+  double increment_min;
+  double increment_max;
+  if (var->arithmetic_type() == InductionVariable::kAddition) {
+    increment_min = increment_type->Min();
+    increment_max = increment_type->Max();
+  } else {
+    DCHECK_EQ(InductionVariable::kSubtraction, var->arithmetic_type());
+    increment_min = -increment_type->Max();
+    increment_max = -increment_type->Min();
+  }
+
+  double min = -V8_INFINITY;
+  double max = V8_INFINITY;
+  if (increment_min >= 0) {
+    // Increasing sequence: the value on the backedge is bounded by the upper
+    // bounds checked in the loop plus the increment.
+    min = initial_type->Min();
+    for (InductionVariable::Bound const& bound : var->upper_bounds()) {
+      Type* bound_type = TypeOrNone(bound.bound);
+      // If the type is not an integer, just skip the bound.
+      if (!bound_type->Is(typer_->cache_.kInteger)) continue;
+      // If the type is not inhabited, then we can take the initial value.
+      if (!bound_type->IsInhabited()) {
+        max = initial_type->Max();
+        break;
+      }
+      double bound_max = bound_type->Max();
+      if (bound.kind == InductionVariable::kStrict) bound_max -= 1;
+      max = std::min(max, bound_max + increment_max);
+    }
+    // The upper bound must be at least the initial value's upper bound.
+    max = std::max(max, initial_type->Max());
+  } else if (increment_max <= 0) {
+    // Decreasing sequence, symmetric to the case above.
+    max = initial_type->Max();
+    for (InductionVariable::Bound const& bound : var->lower_bounds()) {
+      Type* bound_type = TypeOrNone(bound.bound);
+      if (!bound_type->Is(typer_->cache_.kInteger)) continue;
+      if (!bound_type->IsInhabited()) {
+        min = initial_type->Min();
+        break;
+      }
+      double bound_min = bound_type->Min();
+      if (bound.kind == InductionVariable::kStrict) bound_min += 1;
+      min = std::max(min, bound_min + increment_min);
+    }
+    // The lower bound must be at most the initial value's lower bound.
+    min = std::min(min, initial_type->Min());
+  } else {
+    // If the increment can be both positive and negative, the variable can
+    // go arbitrarily far, so just return integer.
+    return typer_->cache_.kInteger;
+  }
+  return Type::Range(min, max, zone());
+}
+
+
 Type* Typer::Visitor::TypeEffectPhi(Node* node) {
   UNREACHABLE();
   return nullptr;
@@ -641,6 +776,11 @@ Type* Typer::Visitor::TypeTypedStateValues(Node* node) {
 }
 
 
+Type* Typer::Visitor::TypeObjectState(Node* node) {
+  return Type::Internal(zone());
+}
+
+
 Type* Typer::Visitor::TypeCall(Node* node) { return Type::Any(); }
 
 
@@ -2412,6 +2552,9 @@ Type* Typer::Visitor::TypeCheckedStore(Node* node) {
 }
 
 
+Type* Typer::Visitor::TypeAtomicLoad(Node* node) { return Type::Any(); }
+
+
 // Heap constants.
 
 
@@ -18,6 +18,8 @@ class TypeCache;
 
 namespace compiler {
 
+class LoopVariableOptimizer;
+
 
 class Typer {
  public:
@@ -36,6 +38,10 @@ class Typer {
   void Run();
   // TODO(bmeurer,jarin): Remove this once we have a notion of "roots" on Graph.
   void Run(const ZoneVector<Node*>& roots);
+  // Types the graph, using the ranges of the induction variables found by
+  // {induction_vars} instead of widening the types of their phis.
+  void Run(const ZoneVector<Node*>& roots,
+           LoopVariableOptimizer* induction_vars);
 
  private:
   class Visitor;
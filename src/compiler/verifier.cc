@@ -439,6 +439,10 @@ void Verifier::Visitor::Check(Node* node) {
     case IrOpcode::kTypedStateValues:
       // TODO(jarin): what are the constraints on these?
       break;
+    case IrOpcode::kObjectState:
+      CHECK_EQ(0, effect_count);
+      CHECK_EQ(0, control_count);
+      break;
     case IrOpcode::kCall:
       // TODO(rossberg): what are the constraints on these?
       break;
@@ -935,6 +939,7 @@ void Verifier::Visitor::Check(Node* node) {
     case IrOpcode::kLoadFramePointer:
     case IrOpcode::kCheckedLoad:
     case IrOpcode::kCheckedStore:
+    case IrOpcode::kAtomicLoad:
       // TODO(rossberg): Check.
       break;
   }
@@ -118,14 +118,17 @@ int InstructionScheduler::GetTargetInstructionFlags(
     case kX64BitcastDL:
     case kX64BitcastIF:
     case kX64BitcastLD:
-    case kX64Lea32:
-    case kX64Lea:
     case kX64Dec32:
     case kX64Inc32:
       return (instr->addressing_mode() == kMode_None)
           ? kNoOpcodeFlags
           : kIsLoadOperation | kHasSideEffect;
 
+    case kX64Lea32:
+    case kX64Lea:
+      // The memory operand of lea is only used for address computation.
+      return kNoOpcodeFlags;
+
     case kX64Movsxbl:
     case kX64Movzxbl:
     case kX64Movsxwl:
@@ -172,9 +175,167 @@ int InstructionScheduler::GetTargetInstructionFlags(
 }
 
 
+namespace {
+
+// Latency of a load that hits in the L1 cache.
+const int kLoadLatency = 5;
+
+}  // namespace
+
+
 int InstructionScheduler::GetInstructionLatency(const Instruction* instr) {
-  // TODO(all): Add instruction cost modeling.
-  return 1;
+  // Basic latency modeling for x64 instructions, roughly matching recent
+  // Intel cores (Haswell and Skylake). Instructions that read one of their
+  // operands from memory have to wait for the load first.
+  int const load_latency =
+      (instr->addressing_mode() == kMode_None) ? 0 : kLoadLatency;
+  switch (instr->arch_opcode()) {
+    case kX64Lea32:
+    case kX64Lea:
+      return 1;
+
+    case kX64Imul:
+    case kX64Imul32:
+      return load_latency + 3;
+
+    case kX64ImulHigh32:
+    case kX64UmulHigh32:
+      return load_latency + 4;
+
+    case kX64Idiv32:
+    case kX64Udiv32:
+      return load_latency + 26;
+
+    case kX64Idiv:
+    case kX64Udiv:
+      return load_latency + 40;
+
+    case kX64Lzcnt:
+    case kX64Lzcnt32:
+    case kX64Tzcnt:
+    case kX64Tzcnt32:
+    case kX64Popcnt:
+    case kX64Popcnt32:
+      return load_latency + 3;
+
+    case kSSEFloat32Abs:
+    case kSSEFloat32Neg:
+    case kSSEFloat64Abs:
+    case kSSEFloat64Neg:
+    case kAVXFloat32Abs:
+    case kAVXFloat32Neg:
+    case kAVXFloat64Abs:
+    case kAVXFloat64Neg:
+      return load_latency + 1;
+
+    case kX64BitcastFI:
+    case kX64BitcastDL:
+    case kX64BitcastIF:
+    case kX64BitcastLD:
+    case kSSEFloat64ExtractLowWord32:
+    case kSSEFloat64ExtractHighWord32:
+      return load_latency + 2;
+
+    case kSSEFloat32Cmp:
+    case kSSEFloat64Cmp:
+    case kAVXFloat32Cmp:
+    case kAVXFloat64Cmp:
+    case kSSEFloat64InsertLowWord32:
+    case kSSEFloat64InsertHighWord32:
+      return load_latency + 3;
+
+    case kSSEFloat32Add:
+    case kSSEFloat32Sub:
+    case kSSEFloat32Mul:
+    case kSSEFloat32Max:
+    case kSSEFloat32Min:
+    case kSSEFloat64Add:
+    case kSSEFloat64Sub:
+    case kSSEFloat64Mul:
+    case kSSEFloat64Max:
+    case kSSEFloat64Min:
+    case kAVXFloat32Add:
+    case kAVXFloat32Sub:
+    case kAVXFloat32Mul:
+    case kAVXFloat32Max:
+    case kAVXFloat32Min:
+    case kAVXFloat64Add:
+    case kAVXFloat64Sub:
+    case kAVXFloat64Mul:
+    case kAVXFloat64Max:
+    case kAVXFloat64Min:
+    case kSSEInt32ToFloat64:
+    case kSSEInt64ToFloat32:
+    case kSSEInt64ToFloat64:
+    case kSSEUint32ToFloat64:
+      return load_latency + 4;
+
+    case kSSEFloat32ToFloat64:
+    case kSSEFloat64ToFloat32:
+      return load_latency + 5;
+
+    case kSSEFloat64ToInt32:
+    case kSSEFloat64ToUint32:
+    case kSSEFloat64ToInt64:
+    case kSSEFloat32ToInt64:
+      return load_latency + 6;
+
+    case kSSEFloat32Round:
+    case kSSEFloat64Round:
+      return load_latency + 8;
+
+    case kSSEFloat64ToUint64:
+    case kSSEFloat32ToUint64:
+    case kSSEUint64ToFloat32:
+    case kSSEUint64ToFloat64:
+      // These are expanded to short sequences with a branch.
+      return load_latency + 10;
+
+    case kSSEFloat32Div:
+    case kAVXFloat32Div:
+      return load_latency + 11;
+
+    case kSSEFloat32Sqrt:
+      return load_latency + 12;
+
+    case kSSEFloat64Div:
+    case kAVXFloat64Div:
+      return load_latency + 14;
+
+    case kSSEFloat64Sqrt:
+      return load_latency + 18;
+
+    case kSSEFloat64Mod:
+      // Implemented with an x87 fprem loop.
+      return 50;
+
+    case kX64Movsxbl:
+    case kX64Movzxbl:
+    case kX64Movsxwl:
+    case kX64Movzxwl:
+    case kX64Movsxlq:
+    case kX64Movl:
+    case kX64Movq:
+    case kX64Movsd:
+    case kX64Movss:
+    case kSSEFloat64LoadLowWord32:
+      // Stores do not define a value, so their latency does not matter.
+      return instr->HasOutput() ? load_latency + 1 : 1;
+
+    case kX64StackCheck:
+    case kCheckedLoadInt8:
+    case kCheckedLoadUint8:
+    case kCheckedLoadInt16:
+    case kCheckedLoadUint16:
+    case kCheckedLoadWord32:
+    case kCheckedLoadWord64:
+    case kCheckedLoadFloat32:
+    case kCheckedLoadFloat64:
+      return kLoadLatency;
+
+    default:
+      return load_latency + 1;
+  }
 }
 
 }  // namespace compiler
@@ -590,6 +590,8 @@ double AggregatedMemoryHistogram<Histogram>::Aggregate(double current_ms,
   SC(total_preparse_skipped, V8.TotalPreparseSkipped)                 \
   /* Number of symbol lookups skipped using preparsing */             \
   SC(total_preparse_symbols_skipped, V8.TotalPreparseSymbolSkipped)   \
+  /* Number of functions skipped using retained preparse data. */     \
+  SC(retained_preparse_skipped, V8.RetainedPreparseSkipped)           \
   /* Amount of compiled source code. */                               \
   SC(total_compile_size, V8.TotalCompileSize)                         \
   /* Amount of source code compiled with the full codegen. */         \
@@ -838,7 +838,10 @@ MaybeHandle<JSArray> LiveEdit::GatherCompileInfo(Handle<Script> script,
   FunctionInfoListener listener(isolate);
   Handle<Object> original_source =
       Handle<Object>(script->source(), isolate);
+  // The preparse data only describes the original source.
+  Handle<Object> original_preparse_data(script->preparse_data(), isolate);
   script->set_source(*source);
+  script->set_preparse_data(isolate->heap()->undefined_value());
   isolate->set_active_function_info_listener(&listener);
 
   {
@@ -888,6 +891,7 @@ MaybeHandle<JSArray> LiveEdit::GatherCompileInfo(Handle<Script> script,
   // A logical 'finally' section.
   isolate->set_active_function_info_listener(NULL);
   script->set_source(*original_source);
+  script->set_preparse_data(*original_preparse_data);
 
   if (rethrow_exception.is_null()) {
     return listener.GetResult();
@@ -1405,6 +1409,8 @@ Handle<Object> LiveEdit::ChangeScriptSource(Handle<Script> original_script,
 
   // Drop line ends so that they will be recalculated.
   original_script->set_line_ends(isolate->heap()->undefined_value());
+  // Drop the preparse data, which describes the old source.
+  original_script->set_preparse_data(isolate->heap()->undefined_value());
 
   return old_script_object;
 }
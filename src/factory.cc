@@ -882,6 +882,7 @@ Handle<Script> Factory::NewScript(Handle<String> source) {
   script->set_eval_from_instructions_offset(0);
   script->set_shared_function_infos(Smi::FromInt(0));
   script->set_flags(0);
+  script->set_preparse_data(heap->undefined_value());
 
   heap->set_script_list(*WeakFixedArray::Add(script_list(), script));
   return script;
@@ -212,6 +212,40 @@ bool Bytecodes::IsJumpOrReturn(Bytecode bytecode) {
 }
 
 
+// static
+bool Bytecodes::IsStarLookahead(Bytecode bytecode) {
+  // These bytecodes produce a value in the accumulator which is very often
+  // immediately stored to a register, so the (bytecode, Star) pair is worth
+  // handling without a second indirect dispatch.
+  switch (bytecode) {
+    case Bytecode::kLdaZero:
+    case Bytecode::kLdaSmi8:
+    case Bytecode::kLdaUndefined:
+    case Bytecode::kLdaNull:
+    case Bytecode::kLdaTheHole:
+    case Bytecode::kLdaConstant:
+    case Bytecode::kLdaGlobalSloppy:
+    case Bytecode::kLdaGlobalStrict:
+    case Bytecode::kLdaContextSlot:
+    case Bytecode::kLoadICSloppy:
+    case Bytecode::kLoadICStrict:
+    case Bytecode::kKeyedLoadICSloppy:
+    case Bytecode::kKeyedLoadICStrict:
+    case Bytecode::kAdd:
+    case Bytecode::kSub:
+    case Bytecode::kMul:
+    case Bytecode::kInc:
+    case Bytecode::kDec:
+    case Bytecode::kTypeOf:
+    case Bytecode::kCall:
+    case Bytecode::kNew:
+      return true;
+    default:
+      return false;
+  }
+}
+
+
 // static
 std::ostream& Bytecodes::Decode(std::ostream& os, const uint8_t* bytecode_start,
                                 int parameter_count) {
@@ -376,6 +376,10 @@ class Bytecodes {
   // Return true if the bytecode is a conditional jump, a jump, or a return.
   static bool IsJumpOrReturn(Bytecode bytecode);
 
+  // Return true if the handler for |bytecode| should look ahead and inline a
+  // subsequent Star bytecode rather than dispatching to it.
+  static bool IsStarLookahead(Bytecode bytecode);
+
   // Decode a single bytecode and operands to |os|.
   static std::ostream& Decode(std::ostream& os, const uint8_t* bytecode_start,
                               int number_of_parameters);
@@ -4,12 +4,17 @@
 
 #include "src/interpreter/interpreter.h"
 
+#include <fstream>
+
 #include "src/code-factory.h"
 #include "src/compiler.h"
 #include "src/compiler/interpreter-assembler.h"
 #include "src/factory.h"
 #include "src/interpreter/bytecode-generator.h"
 #include "src/interpreter/bytecodes.h"
+#include "src/isolate-inl.h"
+#include "src/log.h"
+#include "src/profiler/cpu-profiler.h"
 #include "src/zone.h"
 
 namespace v8 {
@@ -21,8 +26,14 @@ using compiler::Node;
 #define __ assembler->
 
 
-Interpreter::Interpreter(Isolate* isolate)
-    : isolate_(isolate) {}
+Interpreter::Interpreter(Isolate* isolate) : isolate_(isolate) {
+  if (FLAG_trace_ignition_dispatches) {
+    static const int kTableSize = kNumberOfBytecodes * kNumberOfBytecodes;
+    bytecode_dispatch_counters_table_.Reset(new uintptr_t[kTableSize]);
+    memset(bytecode_dispatch_counters_table_.get(), 0,
+           sizeof(uintptr_t) * kTableSize);
+  }
+}
 
 
 // static
@@ -41,7 +52,10 @@ Handle<FixedArray> Interpreter::CreateUninitializedInterpreterTable(
 void Interpreter::Initialize() {
   DCHECK(FLAG_ignition);
   Handle<FixedArray> handler_table = isolate_->factory()->interpreter_table();
-  if (!IsInterpreterTableInitialized(handler_table)) {
+  // Handlers which count their dispatches are never part of the snapshot, so
+  // regenerate them if dispatch tracing is enabled.
+  if (bytecode_dispatch_counters_table_.get() != nullptr ||
+      !IsInterpreterTableInitialized(handler_table)) {
     Zone zone;
     HandleScope scope(isolate_);
 
@@ -51,6 +65,8 @@ void Interpreter::Initialize() {
                                                Bytecode::k##Name);    \
       Do##Name(&assembler);                                           \
       Handle<Code> code = assembler.GenerateCode();                   \
+      PROFILE(isolate_, CodeCreateEvent(Logger::BYTECODE_HANDLER_TAG, \
+                                        *code, #Name));               \
       handler_table->set(static_cast<int>(Bytecode::k##Name), *code); \
     }
     BYTECODE_LIST(GENERATE_CODE)
@@ -76,6 +92,75 @@ bool Interpreter::MakeBytecode(CompilationInfo* info) {
 }
 
 
+uintptr_t Interpreter::GetDispatchCounter(Bytecode from, Bytecode to) const {
+  DCHECK_NOT_NULL(bytecode_dispatch_counters_table_.get());
+  int from_index = Bytecodes::ToByte(from);
+  int to_index = Bytecodes::ToByte(to);
+  return bytecode_dispatch_counters_table_[from_index * kNumberOfBytecodes +
+                                           to_index];
+}
+
+
+void Interpreter::WriteDispatchCounters() {
+  DCHECK_NOT_NULL(bytecode_dispatch_counters_table_.get());
+  std::ofstream os(FLAG_trace_ignition_dispatches_output_file,
+                   std::ios_base::trunc);
+  os << "{";
+  bool first_source = true;
+  for (int from_index = 0; from_index < kNumberOfBytecodes; ++from_index) {
+    Bytecode from = Bytecodes::FromByte(static_cast<uint8_t>(from_index));
+    bool first_target = true;
+    for (int to_index = 0; to_index < kNumberOfBytecodes; ++to_index) {
+      Bytecode to = Bytecodes::FromByte(static_cast<uint8_t>(to_index));
+      uintptr_t counter = GetDispatchCounter(from, to);
+      if (counter == 0) continue;
+      if (first_target) {
+        if (!first_source) os << ",";
+        os << "\n  \"" << Bytecodes::ToString(from) << "\": {";
+        first_source = false;
+      } else {
+        os << ",";
+      }
+      os << "\n    \"" << Bytecodes::ToString(to) << "\": " << counter;
+      first_target = false;
+    }
+    if (!first_target) os << "\n  }";
+  }
+  os << "\n}\n";
+}
+
+
+Handle<JSObject> Interpreter::GetDispatchCountersObject() {
+  DCHECK_NOT_NULL(bytecode_dispatch_counters_table_.get());
+  Factory* factory = isolate_->factory();
+  Handle<JSObject> counters_map =
+      factory->NewJSObject(isolate_->object_function());
+
+  for (int from_index = 0; from_index < kNumberOfBytecodes; ++from_index) {
+    Bytecode from = Bytecodes::FromByte(static_cast<uint8_t>(from_index));
+    Handle<JSObject> counters_row;
+    for (int to_index = 0; to_index < kNumberOfBytecodes; ++to_index) {
+      Bytecode to = Bytecodes::FromByte(static_cast<uint8_t>(to_index));
+      uintptr_t counter = GetDispatchCounter(from, to);
+      if (counter == 0) continue;
+      if (counters_row.is_null()) {
+        counters_row = factory->NewJSObject(isolate_->object_function());
+      }
+      Handle<String> to_name =
+          factory->InternalizeUtf8String(Bytecodes::ToString(to));
+      JSObject::AddProperty(counters_row, to_name,
+                            factory->NewNumberFromSize(counter), NONE);
+    }
+    if (counters_row.is_null()) continue;
+    Handle<String> from_name =
+        factory->InternalizeUtf8String(Bytecodes::ToString(from));
+    JSObject::AddProperty(counters_map, from_name, counters_row, NONE);
+  }
+
+  return counters_map;
+}
+
+
 bool Interpreter::IsInterpreterTableInitialized(
     Handle<FixedArray> handler_table) {
   DCHECK(handler_table->length() == static_cast<int>(Bytecode::kLast) + 1);
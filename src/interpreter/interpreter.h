@@ -9,6 +9,7 @@
 // Do not include anything from src/interpreter other than
 // src/interpreter/bytecodes.h here!
 #include "src/base/macros.h"
+#include "src/base/smart-pointers.h"
 #include "src/builtins.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/parsing/token.h"
@@ -43,6 +44,22 @@ class Interpreter {
   // Generate bytecode for |info|.
   static bool MakeBytecode(CompilationInfo* info);
 
+  // Writes the number of dispatches between each pair of bytecode handlers
+  // as a JSON object of the form {"from": {"to": count}} to the
+  // --trace-ignition-dispatches-output-file.
+  void WriteDispatchCounters();
+
+  // Returns the dispatch counters as a JS object of the same shape as the
+  // JSON written by WriteDispatchCounters().
+  Handle<JSObject> GetDispatchCountersObject();
+
+  // Returns the number of dispatches from |from| to |to| recorded so far.
+  uintptr_t GetDispatchCounter(Bytecode from, Bytecode to) const;
+
+  uintptr_t* bytecode_dispatch_counters_table() {
+    return bytecode_dispatch_counters_table_.get();
+  }
+
  private:
 // Bytecode handler generator functions.
 #define DECLARE_BYTECODE_HANDLER_GENERATOR(Name, ...) \
@@ -105,7 +122,10 @@ class Interpreter {
 
   bool IsInterpreterTableInitialized(Handle<FixedArray> handler_table);
 
+  static const int kNumberOfBytecodes = static_cast<int>(Bytecode::kLast) + 1;
+
   Isolate* isolate_;
+  base::SmartArrayPointer<uintptr_t> bytecode_dispatch_counters_table_;
 
   DISALLOW_COPY_AND_ASSIGN(Interpreter);
 };
@@ -1891,6 +1891,10 @@ void Isolate::Deinit() {
 
   DumpAndResetCompilationStats();
 
+  if (interpreter_->bytecode_dispatch_counters_table() != nullptr) {
+    interpreter_->WriteDispatchCounters();
+  }
+
   if (FLAG_print_deopt_stress) {
     PrintF(stdout, "=== Stress deopt counter: %u\n", stress_deopt_count_);
   }
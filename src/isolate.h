@@ -387,6 +387,7 @@ typedef List<HeapObject*> DebugObjectCache;
   V(uint32_t, per_isolate_assert_data, 0xFFFFFFFFu)                            \
   V(PromiseRejectCallback, promise_reject_callback, NULL)                      \
   V(const v8::StartupData*, snapshot_blob, NULL)                               \
+  V(intptr_t*, api_external_references, NULL)                                 \
   ISOLATE_INIT_SIMULATOR_LIST(V)
 
 #define THREAD_LOCAL_TOP_ACCESSOR(type, name)                        \
@@ -1345,6 +1346,7 @@ class Isolate {
   friend class TestCodeRangeScope;
   friend class v8::Isolate;
   friend class v8::Locker;
+  friend class v8::SnapshotCreator;
   friend class v8::Unlocker;
   friend v8::StartupData v8::V8::CreateSnapshotDataBlob(const char*);
 
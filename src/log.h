@@ -95,6 +95,7 @@ struct TickSample;
   V(TICK_EVENT,                     "tick")                             \
   V(REPEAT_META_EVENT,              "repeat")                           \
   V(BUILTIN_TAG,                    "Builtin")                          \
+  V(BYTECODE_HANDLER_TAG,           "BytecodeHandler")                  \
   V(CALL_DEBUG_BREAK_TAG,           "CallDebugBreak")                   \
   V(CALL_DEBUG_PREPARE_STEP_IN_TAG, "CallDebugPrepareStepIn")           \
   V(CALL_INITIALIZE_TAG,            "CallInitialize")                   \
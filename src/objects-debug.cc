@@ -1018,6 +1018,7 @@ void Script::ScriptVerify() {
   VerifyPointer(name());
   VerifyPointer(wrapper());
   VerifyPointer(line_ends());
+  VerifyPointer(preparse_data());
 }
 
 
@@ -1127,6 +1127,7 @@ void Script::ScriptPrint(std::ostream& os) {  // NOLINT
   os << "\n - eval from instructions offset: "
      << eval_from_instructions_offset();
   os << "\n - shared function infos: " << Brief(shared_function_infos());
+  os << "\n - preparse data: " << Brief(preparse_data());
   os << "\n";
 }
 
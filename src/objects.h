@@ -6286,6 +6286,12 @@ class Script: public Struct {
   // [source_url]: sourceMappingURL magic comment
   DECL_ACCESSORS(source_mapping_url, Object)
 
+  // [preparse_data]: ByteArray of the preparse data of the functions skipped
+  // while parsing this script, as FunctionEntry records sorted by start
+  // position, or undefined. Lazy compilation uses it to skip inner functions
+  // without preparsing them again. Only valid for the current source.
+  DECL_ACCESSORS(preparse_data, Object)
+
   // [compilation_type]: how the the script was compiled. Encoded in the
   // 'flags' field.
   inline CompilationType compilation_type();
@@ -6365,7 +6371,8 @@ class Script: public Struct {
   static const int kFlagsOffset = kSharedFunctionInfosOffset + kPointerSize;
   static const int kSourceUrlOffset = kFlagsOffset + kPointerSize;
   static const int kSourceMappingUrlOffset = kSourceUrlOffset + kPointerSize;
-  static const int kSize = kSourceMappingUrlOffset + kPointerSize;
+  static const int kPreparseDataOffset = kSourceMappingUrlOffset + kPointerSize;
+  static const int kSize = kPreparseDataOffset + kPointerSize;
 
  private:
   int GetLineNumberWithArray(int code_pos);
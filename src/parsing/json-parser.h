@@ -68,17 +68,30 @@ class JsonParser BASE_EMBEDDED {
   // are tab, carriage-return, newline and space.
 
   inline void AdvanceSkipWhitespace() {
-    do {
-      Advance();
-    } while (c0_ == ' ' || c0_ == '\t' || c0_ == '\n' || c0_ == '\r');
+    Advance();
+    SkipWhitespace();
   }
 
   inline void SkipWhitespace() {
     while (c0_ == ' ' || c0_ == '\t' || c0_ == '\n' || c0_ == '\r') {
+      if (seq_one_byte) {
+        // Skip the rest of the whitespace, e.g. indentation, a word at a time.
+        position_ = ScanOneByteRun(WhitespaceCharacters(), position_ + 1) - 1;
+      }
       Advance();
     }
   }
 
+  // Advances past the run of decimal digits starting at the current character.
+  inline void AdvanceDigits() {
+    if (seq_one_byte) {
+      position_ = ScanOneByteRun(DigitCharacters(), position_) - 1;
+      Advance();
+    } else {
+      while (IsDecimalDigit(c0_)) Advance();
+    }
+  }
+
   inline uc32 AdvanceGetChar() {
     Advance();
     return c0_;
@@ -133,6 +146,11 @@ class JsonParser BASE_EMBEDDED {
 
   template <bool is_internalized>
   Handle<String> ScanJsonString();
+  // Returns the position of the first character at or after {position} that
+  // is not in the class of {classifier}, or the length of the source. Runs
+  // are scanned a word at a time. Only used on one-byte sources.
+  template <typename Classifier>
+  int ScanOneByteRun(const Classifier& classifier, int position);
   // Creates a new string and copies prefix[start..end] into the beginning
   // of it. Then scans the rest of the string, adding characters after the
   // prefix. Called by ScanJsonString when reaching a '\' or non-Latin1 char.
@@ -185,6 +203,43 @@ class JsonParser BASE_EMBEDDED {
   static const int kInitialSpecialStringLength = 32;
   static const int kPretenureTreshold = 100 * 1024;
 
+  // Classifiers for ScanOneByteRun, see CharLanes.
+  typedef CharLanes<uint8_t> ByteLanes;
+
+  struct WhitespaceCharacters {
+    static const bool kAcceptsNonAscii = false;
+    bool Contains(uint8_t c) const {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+    uintptr_t Lanes(uintptr_t word) const {
+      return ByteLanes::InRange(word, ' ', ' ') |
+             ByteLanes::InRange(word, '\t', '\n') |
+             ByteLanes::InRange(word, '\r', '\r');
+    }
+  };
+
+  struct DigitCharacters {
+    static const bool kAcceptsNonAscii = false;
+    bool Contains(uint8_t c) const { return IsDecimalDigit(c); }
+    uintptr_t Lanes(uintptr_t word) const {
+      return ByteLanes::InRange(word, '0', '9');
+    }
+  };
+
+  // The characters of a JSON string that do not end the fast scan: anything
+  // but the quote, the backslash and control characters.
+  struct StringCharacters {
+    static const bool kAcceptsNonAscii = true;
+    bool Contains(uint8_t c) const {
+      return c >= 0x20 && c != '"' && c != '\\';
+    }
+    uintptr_t Lanes(uintptr_t word) const {
+      return ByteLanes::InRange(word, 0x20, 0x7F) &
+             ~(ByteLanes::InRange(word, '"', '"') |
+               ByteLanes::InRange(word, '\\', '\\'));
+    }
+  };
+
 
  private:
   Zone* zone() { return &zone_; }
@@ -554,11 +609,24 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonNumber() {
     int i = 0;
     int digits = 0;
     if (c0_ < '1' || c0_ > '9') return ReportUnexpectedCharacter();
-    do {
-      i = i * 10 + c0_ - '0';
-      digits++;
+    if (seq_one_byte) {
+      int end = ScanOneByteRun(DigitCharacters(), position_);
+      digits = end - position_;
+      if (digits < 10) {
+        const uint8_t* chars = seq_source_->GetChars();
+        for (int pos = position_; pos < end; pos++) {
+          i = i * 10 + chars[pos] - '0';
+        }
+      }
+      position_ = end - 1;
       Advance();
-    } while (IsDecimalDigit(c0_));
+    } else {
+      do {
+        i = i * 10 + c0_ - '0';
+        digits++;
+        Advance();
+      } while (IsDecimalDigit(c0_));
+    }
     if (c0_ != '.' && c0_ != 'e' && c0_ != 'E' && digits < 10) {
       SkipWhitespace();
       return Handle<Smi>(Smi::FromInt((negative ? -i : i)), isolate());
@@ -567,17 +635,13 @@ Handle<Object> JsonParser<seq_one_byte>::ParseJsonNumber() {
   if (c0_ == '.') {
     Advance();
     if (!IsDecimalDigit(c0_)) return ReportUnexpectedCharacter();
-    do {
-      Advance();
-    } while (IsDecimalDigit(c0_));
+    AdvanceDigits();
   }
   if (AsciiAlphaToLower(c0_) == 'e') {
     Advance();
     if (c0_ == '-' || c0_ == '+') Advance();
     if (!IsDecimalDigit(c0_)) return ReportUnexpectedCharacter();
-    do {
-      Advance();
-    } while (IsDecimalDigit(c0_));
+    AdvanceDigits();
   }
   int length = position_ - beg_pos;
   double number;
@@ -748,31 +812,29 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
     // Fast path for existing internalized strings.  If the the string being
     // parsed is not a known internalized string, contains backslashes or
     // unexpectedly reaches the end of string, return with an empty handle.
-    uint32_t running_hash = isolate()->heap()->HashSeed();
-    int position = position_;
-    uc32 c0 = c0_;
-    do {
-      if (c0 == '\\') {
-        c0_ = c0;
-        int beg_pos = position_;
-        position_ = position;
-        return SlowScanJsonString<SeqOneByteString, uint8_t>(source_,
-                                                             beg_pos,
-                                                             position_);
-      }
-      if (c0 < 0x20) return Handle<String>::null();
-      running_hash = StringHasher::AddCharacterCore(running_hash,
-                                                    static_cast<uint16_t>(c0));
-      position++;
-      if (position >= source_length_) return Handle<String>::null();
-      c0 = seq_source_->SeqOneByteStringGet(position);
-    } while (c0 != '"');
+    int position = ScanOneByteRun(StringCharacters(), position_);
+    if (position >= source_length_) return Handle<String>::null();
+    uc32 c0 = seq_source_->SeqOneByteStringGet(position);
+    if (c0 == '\\') {
+      c0_ = c0;
+      int beg_pos = position_;
+      position_ = position;
+      return SlowScanJsonString<SeqOneByteString, uint8_t>(source_, beg_pos,
+                                                           position_);
+    }
+    if (c0 != '"') return Handle<String>::null();
     int length = position - position_;
-    uint32_t hash = (length <= String::kMaxHashCalcLength)
-                        ? StringHasher::GetHashCore(running_hash)
-                        : static_cast<uint32_t>(length);
     Vector<const uint8_t> string_vector(
         seq_source_->GetChars() + position_, length);
+    uint32_t hash = static_cast<uint32_t>(length);
+    if (length <= String::kMaxHashCalcLength) {
+      uint32_t running_hash = isolate()->heap()->HashSeed();
+      for (int i = 0; i < length; i++) {
+        running_hash =
+            StringHasher::AddCharacterCore(running_hash, string_vector[i]);
+      }
+      hash = StringHasher::GetHashCore(running_hash);
+    }
     StringTable* string_table = isolate()->heap()->string_table();
     uint32_t capacity = string_table->Capacity();
     uint32_t entry = StringTable::FirstProbe(hash, capacity);
@@ -806,8 +868,13 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
   }
 
   int beg_pos = position_;
+  if (seq_one_byte) {
+    // Skip to the first quote, backslash or control character.
+    position_ = ScanOneByteRun(StringCharacters(), position_) - 1;
+    Advance();
+  }
   // Fast case for Latin1 only without escape characters.
-  do {
+  while (c0_ != '"') {
     // Check for control character (0x00-0x1f) or unterminated string (<0).
     if (c0_ < 0x20) return Handle<String>::null();
     if (c0_ != '\\') {
@@ -823,7 +890,7 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
                                                            beg_pos,
                                                            position_);
     }
-  } while (c0_ != '"');
+  }
   int length = position_ - beg_pos;
   Handle<String> result =
       factory()->NewRawOneByteString(length, pretenure_).ToHandleChecked();
@@ -836,6 +903,18 @@ Handle<String> JsonParser<seq_one_byte>::ScanJsonString() {
   return result;
 }
 
+
+template <bool seq_one_byte>
+template <typename Classifier>
+int JsonParser<seq_one_byte>::ScanOneByteRun(const Classifier& classifier,
+                                             int position) {
+  DCHECK(seq_one_byte);
+  DisallowHeapAllocation no_gc;
+  return position + ByteLanes::RunLength(classifier,
+                                         seq_source_->GetChars() + position,
+                                         source_length_ - position);
+}
+
 }  // namespace internal
 }  // namespace v8
 
@@ -0,0 +1,609 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/parsing/parallel-preparser.h"
+
+#include "src/base/smart-pointers.h"
+#include "src/base/sys-info.h"
+#include "src/cancelable-task.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/parsing/parser.h"
+#include "src/parsing/preparser.h"
+#include "src/parsing/scanner-character-streams.h"
+#include "src/unicode-cache.h"
+#include "src/v8.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// The character-level pass does not need to be exact: it only decides which
+// bodies are preparsed in the background, not how the script is parsed. It
+// skips strings, template literals, comments and regular expressions so that
+// their braces do not confuse it, and bails out of anything unusual.
+
+bool IsWhiteSpaceChar(uc16 c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+
+bool IsLineTerminatorChar(uc16 c) { return c == '\n' || c == '\r'; }
+
+
+// Everything that is not ASCII is treated as part of an identifier, which
+// is good enough to find the keywords we are looking for.
+bool IsIdentifierChar(uc16 c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '$' || c == '_' || c == '\\' ||
+         c >= 0x80;
+}
+
+
+// Returns true if a '/' after {c} starts a regular expression rather than a
+// division, where {c} is the last character of the preceding token, or 0 at
+// the start of the script. Identifiers and literals are represented by 'a'.
+bool IsRegExpPrefix(uc16 c) {
+  switch (c) {
+    case 0:
+    case '(':
+    case ',':
+    case '=':
+    case ':':
+    case '[':
+    case '!':
+    case '&':
+    case '|':
+    case '?':
+    case '{':
+    case ';':
+    case '+':
+    case '-':
+    case '*':
+    case '%':
+    case '<':
+    case '>':
+    case '~':
+    case '^':
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+template <typename Char>
+class FunctionFinder {
+ public:
+  FunctionFinder(const Char* chars, int length,
+                 List<ParallelPreParser::Function>* functions)
+      : chars_(chars),
+        length_(length),
+        functions_(functions),
+        lazy_depth_(0),
+        language_mode_(SLOPPY) {}
+
+  void Run(LanguageMode language_mode);
+
+ private:
+  // Bodies of functions that are parenthesized are parsed eagerly, so their
+  // nested functions are still candidates.
+  enum BraceKind { kBlock, kEagerFunctionBody, kLazyFunctionBody };
+
+  struct Brace {
+    Brace() : kind(kBlock), outer_language_mode(SLOPPY) {}
+    Brace(BraceKind kind, LanguageMode outer_language_mode)
+        : kind(kind), outer_language_mode(outer_language_mode) {}
+
+    BraceKind kind;
+    LanguageMode outer_language_mode;
+  };
+
+  // Limits the recursion for template literals nested in substitutions.
+  static const int kMaxTemplateDepth = 32;
+
+  uc16 At(int pos) const { return pos < length_ ? chars_[pos] : 0; }
+  bool Matches(int start, int end, const char* word) const;
+  bool IsKeywordBeforeExpression(int start, int end) const;
+  bool IsUseStrictDirective(int pos) const;
+
+  // All of these take the position after the opening character(s) and return
+  // the position after the closing ones.
+  int SkipTrivia(int pos) const;
+  int SkipLineComment(int pos) const;
+  int SkipBlockComment(int pos) const;
+  int SkipString(int pos, uc16 quote) const;
+  int SkipTemplate(int pos, int depth) const;
+  int SkipRegExp(int pos) const;
+
+  // Takes the position after the 'function' keyword, and advances it past the
+  // '{' that opens the body. Returns false, with {pos_inout} where it gave
+  // up, if it could not find the body.
+  bool ScanFunction(int* pos_inout, bool parenthesized);
+
+  const Char* chars_;
+  int length_;
+  List<ParallelPreParser::Function>* functions_;
+
+  List<Brace> braces_;
+  int lazy_depth_;
+  LanguageMode language_mode_;
+};
+
+
+template <typename Char>
+bool FunctionFinder<Char>::Matches(int start, int end, const char* word) const {
+  int i = 0;
+  for (; word[i] != '\0'; i++) {
+    if (start + i >= end || chars_[start + i] != word[i]) return false;
+  }
+  return start + i == end;
+}
+
+
+template <typename Char>
+bool FunctionFinder<Char>::IsKeywordBeforeExpression(int start, int end) const {
+  static const char* const kKeywords[] = {
+      "return", "typeof", "instanceof", "in",   "of",    "new",  "delete",
+      "void",   "throw",  "case",       "do",   "else",  "yield"};
+  for (size_t i = 0; i < arraysize(kKeywords); i++) {
+    if (Matches(start, end, kKeywords[i])) return true;
+  }
+  return false;
+}
+
+
+template <typename Char>
+bool FunctionFinder<Char>::IsUseStrictDirective(int pos) const {
+  static const char kUseStrict[] = "use strict";
+  uc16 quote = At(pos);
+  if (quote != '"' && quote != '\'') return false;
+  int end = pos + 1 + static_cast<int>(arraysize(kUseStrict)) - 1;
+  return Matches(pos + 1, end, kUseStrict) && At(end) == quote;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipTrivia(int pos) const {
+  while (pos < length_) {
+    uc16 c = chars_[pos];
+    if (IsWhiteSpaceChar(c)) {
+      pos++;
+    } else if (c == '/' && At(pos + 1) == '/') {
+      pos = SkipLineComment(pos + 2);
+    } else if (c == '/' && At(pos + 1) == '*') {
+      pos = SkipBlockComment(pos + 2);
+    } else {
+      break;
+    }
+  }
+  return pos;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipLineComment(int pos) const {
+  while (pos < length_ && !IsLineTerminatorChar(chars_[pos])) pos++;
+  return pos;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipBlockComment(int pos) const {
+  while (pos < length_) {
+    if (chars_[pos] == '*' && At(pos + 1) == '/') return pos + 2;
+    pos++;
+  }
+  return pos;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipString(int pos, uc16 quote) const {
+  while (pos < length_) {
+    uc16 c = chars_[pos++];
+    if (c == '\\') {
+      // Skip the escaped character, which may be a line continuation.
+      if (At(pos) == '\r' && At(pos + 1) == '\n') pos++;
+      pos++;
+    } else if (c == quote || IsLineTerminatorChar(c)) {
+      break;
+    }
+  }
+  return pos;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipTemplate(int pos, int depth) const {
+  if (depth > kMaxTemplateDepth) return length_;
+  while (pos < length_) {
+    uc16 c = chars_[pos++];
+    if (c == '\\') {
+      pos++;
+    } else if (c == '`') {
+      break;
+    } else if (c == '$' && At(pos) == '{') {
+      // Skip the substitution, minding braces and nested literals.
+      int braces = 1;
+      pos++;
+      while (pos < length_ && braces > 0) {
+        c = chars_[pos++];
+        if (c == '{') {
+          braces++;
+        } else if (c == '}') {
+          braces--;
+        } else if (c == '"' || c == '\'') {
+          pos = SkipString(pos, c);
+        } else if (c == '`') {
+          pos = SkipTemplate(pos, depth + 1);
+        }
+      }
+    }
+  }
+  return pos;
+}
+
+
+template <typename Char>
+int FunctionFinder<Char>::SkipRegExp(int pos) const {
+  bool in_class = false;
+  while (pos < length_) {
+    uc16 c = chars_[pos++];
+    if (c == '\\') {
+      pos++;
+    } else if (IsLineTerminatorChar(c)) {
+      break;
+    } else if (in_class) {
+      if (c == ']') in_class = false;
+    } else if (c == '[') {
+      in_class = true;
+    } else if (c == '/') {
+      break;
+    }
+  }
+  return pos;
+}
+
+
+template <typename Char>
+bool FunctionFinder<Char>::ScanFunction(int* pos_inout, bool parenthesized) {
+  int pos = SkipTrivia(*pos_inout);
+  FunctionKind kind = kNormalFunction;
+  if (At(pos) == '*') {
+    kind = kGeneratorFunction;
+    pos = SkipTrivia(pos + 1);
+  }
+  while (pos < length_ && IsIdentifierChar(chars_[pos])) pos++;
+  pos = SkipTrivia(pos);
+  *pos_inout = pos;
+  if (At(pos) != '(') return false;
+
+  // Any default value, rest parameter or pattern makes the parameters
+  // non-simple. Leave default values with literals to the caller.
+  bool has_simple_parameters = true;
+  int parens = 0;
+  while (pos < length_) {
+    uc16 c = chars_[pos];
+    if (c == '/' && At(pos + 1) == '/') {
+      pos = SkipLineComment(pos + 2);
+      continue;
+    } else if (c == '/' && At(pos + 1) == '*') {
+      pos = SkipBlockComment(pos + 2);
+      continue;
+    } else if (c == '/' || c == '"' || c == '\'' || c == '`') {
+      *pos_inout = pos;
+      return false;
+    } else if (c == '(') {
+      parens++;
+    } else if (c == ')') {
+      if (--parens == 0) break;
+    } else if (c == '=' || c == '[' || c == '{' || c == '.') {
+      has_simple_parameters = false;
+    }
+    pos++;
+  }
+  pos = SkipTrivia(pos + 1);
+  *pos_inout = pos;
+  if (At(pos) != '{') return false;
+
+  if (!parenthesized && lazy_depth_ == 0) {
+    functions_->Add(ParallelPreParser::Function(pos, language_mode_, kind,
+                                                has_simple_parameters));
+  }
+  braces_.Add(Brace(parenthesized ? kEagerFunctionBody : kLazyFunctionBody,
+                    language_mode_));
+  if (!parenthesized) lazy_depth_++;
+  *pos_inout = pos + 1;
+  if (IsUseStrictDirective(SkipTrivia(pos + 1))) language_mode_ = STRICT;
+  return true;
+}
+
+
+template <typename Char>
+void FunctionFinder<Char>::Run(LanguageMode language_mode) {
+  language_mode_ = language_mode;
+  if (IsUseStrictDirective(SkipTrivia(0))) language_mode_ = STRICT;
+
+  // The last character of the previous token, to tell regular expressions
+  // from divisions.
+  uc16 last = 0;
+  int pos = 0;
+  while (pos < length_) {
+    uc16 c = chars_[pos];
+    if (IsWhiteSpaceChar(c)) {
+      pos++;
+    } else if (c == '/' && At(pos + 1) == '/') {
+      pos = SkipLineComment(pos + 2);
+    } else if (c == '/' && At(pos + 1) == '*') {
+      pos = SkipBlockComment(pos + 2);
+    } else if (c == '/' && IsRegExpPrefix(last)) {
+      pos = SkipRegExp(pos + 1);
+      last = 'a';
+    } else if (c == '"' || c == '\'') {
+      pos = SkipString(pos + 1, c);
+      last = 'a';
+    } else if (c == '`') {
+      pos = SkipTemplate(pos + 1, 0);
+      last = 'a';
+    } else if (c == '{') {
+      braces_.Add(Brace(kBlock, language_mode_));
+      pos++;
+      last = c;
+    } else if (c == '}') {
+      if (!braces_.is_empty()) {
+        Brace brace = braces_.RemoveLast();
+        if (brace.kind == kLazyFunctionBody) lazy_depth_--;
+        language_mode_ = brace.outer_language_mode;
+      }
+      pos++;
+      last = c;
+    } else if (IsIdentifierChar(c)) {
+      int start = pos;
+      while (pos < length_ && IsIdentifierChar(chars_[pos])) pos++;
+      if (Matches(start, pos, "function")) {
+        last = ScanFunction(&pos, last == '(') ? '{' : 'a';
+      } else {
+        last = IsKeywordBeforeExpression(start, pos) ? '(' : 'a';
+      }
+    } else {
+      pos++;
+      last = c;
+    }
+  }
+}
+
+}  // namespace
+
+
+struct ParallelPreParser::Worker {
+  explicit Worker(uint32_t hash_seed)
+      : scanner(&unicode_cache), ast_value_factory(&zone, hash_seed) {}
+
+  Zone zone;
+  UnicodeCache unicode_cache;
+  Scanner scanner;
+  AstValueFactory ast_value_factory;
+  base::SmartPointer<PreParser> preparser;
+  // The functions nested in the function being preparsed.
+  PreparseDataRecorder inner_functions;
+};
+
+
+class ParallelPreParser::Task : public CancelableTask {
+ public:
+  Task(Isolate* isolate, ParallelPreParser* preparser, Worker* worker)
+      : CancelableTask(isolate), preparser_(preparser), worker_(worker) {}
+
+  virtual ~Task() {}
+
+ private:
+  // v8::Task overrides.
+  void RunInternal() override {
+    preparser_->PreParseFunctions(worker_);
+    preparser_->pending_tasks_semaphore_.Signal();
+  }
+
+  ParallelPreParser* preparser_;
+  Worker* worker_;
+
+  DISALLOW_COPY_AND_ASSIGN(Task);
+};
+
+
+ParallelPreParser::ParallelPreParser(Isolate* isolate, Handle<String> source,
+                                     LanguageMode language_mode)
+    : isolate_(isolate),
+      hash_seed_(isolate->heap()->HashSeed()),
+      one_byte_chars_(NULL),
+      two_byte_chars_(NULL),
+      length_(source->length()),
+      owns_chars_(false),
+      cursor_(0),
+      preparsed_count_(0),
+      aborted_(false),
+      pending_tasks_semaphore_(0) {
+  DCHECK(source->IsFlat());
+  // External resources outlive the parser, and do not move.
+  if (source->IsExternalOneByteString()) {
+    one_byte_chars_ = ExternalOneByteString::cast(*source)->GetChars();
+  } else if (source->IsExternalTwoByteString()) {
+    two_byte_chars_ = ExternalTwoByteString::cast(*source)->GetChars();
+  } else if (source->IsOneByteRepresentation()) {
+    uint8_t* chars = NewArray<uint8_t>(length_);
+    String::WriteToFlat(*source, chars, 0, length_);
+    one_byte_chars_ = chars;
+    owns_chars_ = true;
+  } else {
+    uc16* chars = NewArray<uc16>(length_);
+    String::WriteToFlat(*source, chars, 0, length_);
+    two_byte_chars_ = chars;
+    owns_chars_ = true;
+  }
+  if (one_byte_chars_ != NULL) {
+    FunctionFinder<uint8_t>(one_byte_chars_, length_, &functions_)
+        .Run(language_mode);
+  } else {
+    FunctionFinder<uc16>(two_byte_chars_, length_, &functions_)
+        .Run(language_mode);
+  }
+}
+
+
+ParallelPreParser::~ParallelPreParser() {
+  aborted_.SetValue(true);
+  // Tasks that cannot be canceled have either finished or are still running,
+  // so wait for their signal.
+  for (int i = 0; i < task_ids_.length(); i++) {
+    if (!isolate_->cancelable_task_manager()->TryAbort(task_ids_[i])) {
+      pending_tasks_semaphore_.Wait();
+    }
+  }
+  for (int i = 0; i < workers_.length(); i++) delete workers_[i];
+  for (int i = 0; i < functions_.length(); i++) {
+    functions_[i].inner_entries.Dispose();
+  }
+  if (owns_chars_) {
+    DeleteArray(const_cast<uint8_t*>(one_byte_chars_));
+    DeleteArray(const_cast<uc16*>(two_byte_chars_));
+  }
+}
+
+
+bool ParallelPreParser::Start(Parser* parser) {
+  int num_tasks = Min(functions_.length() / kMinFunctionsPerTask,
+                      Min(base::SysInfo::NumberOfProcessors() - 1, kMaxTasks));
+  if (num_tasks < 1) return false;
+  for (int i = 0; i < functions_.length(); i++) {
+    states_.Add(AtomicValue<State>(kPending));
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    Worker* worker = new Worker(hash_seed_);
+    // The stack limit is set on the background thread.
+    worker->preparser.Reset(parser->NewPreParser(
+        &worker->zone, &worker->scanner, &worker->ast_value_factory, 0));
+    if (FLAG_retain_preparse_data) {
+      worker->preparser->set_inner_function_log(&worker->inner_functions);
+    }
+    workers_.Add(worker);
+  }
+  for (int i = 0; i < num_tasks; i++) {
+    Task* task = new Task(isolate_, this, workers_[i]);
+    task_ids_.Add(task->id());
+    V8::GetCurrentPlatform()->CallOnBackgroundThread(
+        task, v8::Platform::kShortRunningTask);
+  }
+  return true;
+}
+
+
+const ParallelPreParser::Function* ParallelPreParser::Lookup(
+    int position, LanguageMode language_mode, FunctionKind kind,
+    bool has_simple_parameters, bool has_bookmark) {
+  // Functions the parser moved past are of no use anymore, e.g. because they
+  // were nested in a function it preparsed itself.
+  while (cursor_ < functions_.length() &&
+         functions_[cursor_].position < position) {
+    states_[cursor_++].TrySetValue(kPending, kSkipped);
+  }
+  if (cursor_ == functions_.length() ||
+      functions_[cursor_].position != position) {
+    return NULL;
+  }
+  Function* function = &functions_[cursor_];
+  AtomicValue<State>* state = &states_[cursor_];
+  cursor_++;
+  // If the guess was wrong, or no task has started on the body yet, the
+  // parser is better off preparsing it right away.
+  if (function->language_mode != language_mode || function->kind != kind ||
+      function->has_simple_parameters != has_simple_parameters) {
+    state->TrySetValue(kPending, kSkipped);
+    return NULL;
+  }
+  if (state->TrySetValue(kPending, kSkipped)) return NULL;
+  {
+    base::LockGuard<base::Mutex> guard(&mutex_);
+    while (state->Value() == kRunning) function_done_.Wait(&mutex_);
+  }
+  if (state->Value() != kDone) return NULL;
+  // Without a bookmark, the parser cannot abort preparsing the function.
+  if (function->aborted && !has_bookmark) return NULL;
+  preparsed_count_++;
+  return function;
+}
+
+
+void ParallelPreParser::PreParseFunctions(Worker* worker) {
+  // The background thread has its own stack.
+  int stack_size = Min(FLAG_stack_size, kWorkerStackSizeInKB);
+  uintptr_t stack_limit =
+      reinterpret_cast<uintptr_t>(&stack_limit) - stack_size * KB;
+  worker->preparser->set_stack_limit(stack_limit);
+  while (!aborted_.Value()) {
+    int index = next_function_.Increment(1) - 1;
+    if (index >= functions_.length()) break;
+    AtomicValue<State>* state = &states_[index];
+    if (!state->TrySetValue(kPending, kRunning)) continue;
+    bool success = PreParseFunction(worker, &functions_[index]);
+    {
+      base::LockGuard<base::Mutex> guard(&mutex_);
+      state->SetValue(success ? kDone : kFailed);
+    }
+    function_done_.NotifyAll();
+  }
+}
+
+
+bool ParallelPreParser::PreParseFunction(Worker* worker, Function* function) {
+  if (one_byte_chars_ != NULL) {
+    GenericStringUtf16CharacterStream stream(one_byte_chars_,
+                                             function->position, length_);
+    return PreParseFunction(worker, function, &stream);
+  }
+  TwoByteBufferUtf16CharacterStream stream(two_byte_chars_,
+                                           function->position, length_);
+  return PreParseFunction(worker, function, &stream);
+}
+
+
+bool ParallelPreParser::PreParseFunction(Worker* worker, Function* function,
+                                         Utf16CharacterStream* stream) {
+  Scanner* scanner = &worker->scanner;
+  scanner->Initialize(stream);
+  scanner->Next();
+  DCHECK_EQ(Token::LBRACE, scanner->current_token());
+
+  // Set a bookmark like the parser does, so that the preparser applies the
+  // same heuristic for aborting.
+  Scanner::BookmarkScope bookmark(scanner);
+  Scanner::BookmarkScope* maybe_bookmark = bookmark.Set() ? &bookmark : nullptr;
+  SingletonLogger logger;
+  worker->inner_functions.Clear();
+  PreParser::PreParseResult result = worker->preparser->PreParseLazyFunction(
+      function->language_mode, function->kind, function->has_simple_parameters,
+      &logger, maybe_bookmark);
+  if (bookmark.HasBeenReset()) {
+    function->aborted = true;
+    return true;
+  }
+  // Let the parser report errors, including stack overflows.
+  if (result == PreParser::kPreParseStackOverflow || logger.has_error()) {
+    return false;
+  }
+  function->end_position = logger.end();
+  function->literal_count = logger.literals();
+  function->property_count = logger.properties();
+  function->result_language_mode = logger.language_mode();
+  function->uses_super_property = logger.uses_super_property();
+  function->calls_eval = logger.calls_eval();
+  if (!worker->inner_functions.is_empty()) {
+    function->inner_entries = worker->inner_functions.entries().Clone();
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,163 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_PARSING_PARALLEL_PREPARSER_H_
+#define V8_PARSING_PARALLEL_PREPARSER_H_
+
+#include "src/atomic-utils.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/semaphore.h"
+#include "src/globals.h"
+#include "src/handles.h"
+#include "src/list.h"
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+class Parser;
+class String;
+class Utf16CharacterStream;
+
+// Preparses the bodies of the top-level functions of a large script on
+// background threads while the main thread parses the script.
+//
+// A cheap character-level pass over the source finds the '{' that opens the
+// body of every function that is not nested in another lazily parsed
+// function, and guesses the language mode, kind and parameter shape the
+// parser will see for it. Background tasks then preparse these bodies in
+// source order. When the parser reaches a lazily parsed function it looks up
+// the result for the position of its body and skips the body like it does
+// with cached parse data. A result is only used if it was produced for exactly
+// the state the parser is in, so a wrong guess only costs background work.
+class ParallelPreParser {
+ public:
+  // A function body found by the character-level pass, together with the
+  // result of preparsing it.
+  struct Function {
+    Function() : Function(0, SLOPPY, kNormalFunction, true) {}
+    Function(int position, LanguageMode language_mode, FunctionKind kind,
+             bool has_simple_parameters)
+        : position(position),
+          language_mode(language_mode),
+          kind(kind),
+          has_simple_parameters(has_simple_parameters),
+          aborted(false),
+          end_position(0),
+          literal_count(0),
+          property_count(0),
+          result_language_mode(SLOPPY),
+          uses_super_property(false),
+          calls_eval(false) {}
+
+    // Position of the '{' that opens the body.
+    int position;
+    // The state the body is preparsed in.
+    LanguageMode language_mode;
+    FunctionKind kind;
+    bool has_simple_parameters;
+
+    // Filled in by the task that preparsed the body.
+    bool aborted;
+    int end_position;
+    int literal_count;
+    int property_count;
+    LanguageMode result_language_mode;
+    bool uses_super_property;
+    bool calls_eval;
+    // The entries of the functions nested in the body, in the layout of
+    // FunctionEntry. Owned by the ParallelPreParser.
+    Vector<unsigned> inner_entries;
+  };
+
+  ParallelPreParser(Isolate* isolate, Handle<String> source,
+                    LanguageMode language_mode);
+  // Cancels the tasks that have not started yet and waits for the others.
+  ~ParallelPreParser();
+
+  // Starts the background tasks. Returns false if the script does not have
+  // enough functions to be worth it. Main thread only.
+  bool Start(Parser* parser);
+
+  // Returns the result for the body of the lazily parsed function starting at
+  // {position}, waiting for it if it is being preparsed right now, or NULL if
+  // the parser has to preparse the body itself. Must be called in increasing
+  // {position} order. Main thread only.
+  const Function* Lookup(int position, LanguageMode language_mode,
+                         FunctionKind kind, bool has_simple_parameters,
+                         bool has_bookmark);
+
+  int function_count() const { return functions_.length(); }
+  int preparsed_count() const { return preparsed_count_; }
+
+ private:
+  class Task;
+  struct Worker;
+
+  enum State {
+    // Not yet preparsed; a task or the main thread may take it.
+    kPending,
+    // A task is preparsing the body.
+    kRunning,
+    kDone,
+    kFailed,
+    // The main thread has taken it, or moved past it.
+    kSkipped
+  };
+
+  static const int kMaxTasks = 4;
+  static const int kMinFunctionsPerTask = 8;
+  // The stack size of the platform's worker threads is unknown and may be
+  // well below --stack-size (e.g. 512KB on Mac), so the tasks only use this
+  // much of it. Functions that need more are preparsed on the main thread.
+  static const int kWorkerStackSizeInKB = 256;
+
+  void FindFunctions(LanguageMode language_mode);
+
+  // Called on background threads.
+  void PreParseFunctions(Worker* worker);
+  bool PreParseFunction(Worker* worker, Function* function);
+  bool PreParseFunction(Worker* worker, Function* function,
+                        Utf16CharacterStream* stream);
+
+  Isolate* isolate_;
+  uint32_t hash_seed_;
+
+  // The source characters, shared by all threads. One-byte sources are kept
+  // in one byte per character.
+  const uint8_t* one_byte_chars_;
+  const uc16* two_byte_chars_;
+  int length_;
+  bool owns_chars_;
+
+  // Sorted by position, and never resized after the tasks have started.
+  List<Function> functions_;
+  // Parallel to {functions_}.
+  List<AtomicValue<State> > states_;
+  // The next function a task takes.
+  AtomicNumber<int> next_function_;
+  // The next function the main thread may ask for.
+  int cursor_;
+  int preparsed_count_;
+
+  List<Worker*> workers_;
+  List<uint32_t> task_ids_;
+  AtomicValue<bool> aborted_;
+
+  // Signaled by the tasks when they are done.
+  base::Semaphore pending_tasks_semaphore_;
+  // Guard the transition out of {kRunning}, so that the main thread can wait
+  // for a body that a task is preparsing.
+  base::Mutex mutex_;
+  base::ConditionVariable function_done_;
+
+  DISALLOW_COPY_AND_ASSIGN(ParallelPreParser);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_PARSING_PARALLEL_PREPARSER_H_
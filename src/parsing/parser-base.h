@@ -137,6 +137,7 @@ class ParserBase : public Traits {
 #undef ALLOW_ACCESSORS
 
   uintptr_t stack_limit() const { return stack_limit_; }
+  void set_stack_limit(uintptr_t stack_limit) { stack_limit_ = stack_limit; }
 
  protected:
   enum AllowRestrictedIdentifiers {
@@ -16,6 +16,7 @@
 #include "src/codegen.h"
 #include "src/compiler.h"
 #include "src/messages.h"
+#include "src/parsing/parallel-preparser.h"
 #include "src/parsing/parameter-initializer-rewriter.h"
 #include "src/parsing/parser-base.h"
 #include "src/parsing/rewriter.h"
@@ -27,7 +28,11 @@ namespace v8 {
 namespace internal {
 
 ScriptData::ScriptData(const byte* data, int length)
-    : owns_data_(false), rejected_(false), data_(data), length_(length) {
+    : owns_data_(false),
+      rejected_(false),
+      prechecked_(false),
+      data_(data),
+      length_(length) {
   if (!IsAligned(reinterpret_cast<intptr_t>(data), kPointerAlignment)) {
     byte* copy = NewArray<byte>(length);
     DCHECK(IsAligned(reinterpret_cast<intptr_t>(copy), kPointerAlignment));
@@ -914,6 +919,9 @@ Parser::Parser(ParseInfo* info)
       target_stack_(NULL),
       compile_options_(info->compile_options()),
       cached_parse_data_(NULL),
+      parallel_preparser_(NULL),
+      retain_preparse_data_(false),
+      retained_preparse_skipped_(0),
       total_preparse_skipped_(0),
       pre_parse_timer_(NULL),
       parsing_on_main_thread_(true) {
@@ -976,6 +984,19 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   source = String::Flatten(source);
   FunctionLiteral* result;
 
+  // Preparse the top-level functions of large scripts on background threads.
+  // Cached data already lets us skip them cheaply.
+  if (FLAG_parallel_preparse && allow_lazy() && !info->is_eval() &&
+      !consume_cached_parse_data() &&
+      source->length() >= FLAG_min_parallel_preparse_length) {
+    parallel_preparser_ =
+        new ParallelPreParser(isolate, source, info->language_mode());
+    if (!parallel_preparser_->Start(this)) {
+      delete parallel_preparser_;
+      parallel_preparser_ = NULL;
+    }
+  }
+
   if (source->IsExternalTwoByteString()) {
     // Notice that the stream is destroyed at the end of the branch block.
     // The last line of the blocks can't be moved outside, even though they're
@@ -992,6 +1013,14 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
   if (result != NULL) {
     DCHECK_EQ(scanner_.peek_location().beg_pos, source->length());
   }
+  int parallel_preparse_count = 0;
+  int parallel_preparse_candidates = 0;
+  if (parallel_preparser_ != NULL) {
+    parallel_preparse_count = parallel_preparser_->preparsed_count();
+    parallel_preparse_candidates = parallel_preparser_->function_count();
+    delete parallel_preparser_;
+    parallel_preparser_ = NULL;
+  }
   HandleSourceURLComments(isolate, info->script());
 
   if (FLAG_trace_parse && result != NULL) {
@@ -1005,6 +1034,10 @@ FunctionLiteral* Parser::ParseProgram(Isolate* isolate, ParseInfo* info) {
     } else {
       PrintF("[parsing script");
     }
+    if (parallel_preparse_candidates > 0) {
+      PrintF(" - %d of %d functions preparsed in parallel",
+             parallel_preparse_count, parallel_preparse_candidates);
+    }
     PrintF(" - took %0.3f ms]\n", ms);
   }
   if (produce_cached_parse_data()) {
@@ -1022,6 +1055,8 @@ FunctionLiteral* Parser::DoParseProgram(ParseInfo* info) {
   DCHECK(scope_ == NULL);
   DCHECK(target_stack_ == NULL);
 
+  retain_preparse_data_ = FLAG_retain_preparse_data;
+
   Mode parsing_mode = FLAG_lazy && allow_lazy() ? PARSE_LAZILY : PARSE_EAGERLY;
   if (allow_natives() || extension_ != NULL) parsing_mode = PARSE_EAGERLY;
 
@@ -1133,6 +1168,14 @@ FunctionLiteral* Parser::ParseLazy(Isolate* isolate, ParseInfo* info) {
   }
   Handle<SharedFunctionInfo> shared_info = info->shared_info();
 
+  // The functions in this function were preparsed when the script was parsed.
+  Object* preparse_data = info->script()->preparse_data();
+  if (FLAG_retain_preparse_data && preparse_data->IsByteArray()) {
+    LoadPreparseData(ByteArray::cast(preparse_data),
+                     shared_info->start_position(),
+                     shared_info->end_position());
+  }
+
   // Initialize parser state.
   source = String::Flatten(source);
   FunctionLiteral* result;
@@ -4354,6 +4397,12 @@ FunctionLiteral* Parser::ParseFunctionLiteral(
     bool is_lazily_parsed = mode() == PARSE_LAZILY &&
                             scope_->AllowsLazyParsing() &&
                             !parenthesized_function_;
+    // When a function is compiled lazily, its inner functions are parsed
+    // eagerly, except for those that the script's preparse data describes.
+    if (!is_lazily_parsed && !preparse_data_.is_empty() &&
+        scope_->AllowsLazyParsing() && !parenthesized_function_) {
+      is_lazily_parsed = LookupPreparseData(position()).is_valid();
+    }
     parenthesized_function_ = false;  // The bit was set for this function only.
 
     // Eager or lazy parse?
@@ -4495,6 +4544,55 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
   if (produce_cached_parse_data()) CHECK(log_);
 
   int function_block_pos = position();
+  if (!preparse_data_.is_empty()) {
+    // The body was preparsed when the script was parsed.
+    FunctionEntry entry = LookupPreparseData(function_block_pos);
+    if (entry.is_valid() && entry.end_pos() > function_block_pos) {
+      SkipPreParsedFunctionBody(entry, function_block_pos,
+                                materialized_literal_count,
+                                expected_property_count, ok);
+      // The variables that the skipped function refers to are not resolved,
+      // so the enclosing functions must keep all of theirs in the context.
+      scope_->outer_scope()->RecordInnerScopeEvalCall();
+      retained_preparse_skipped_++;
+      return;
+    }
+  }
+  if (parallel_preparser_ != NULL) {
+    // The body may have been preparsed on a background thread already. Skip
+    // it as with cached data.
+    const ParallelPreParser::Function* function = parallel_preparser_->Lookup(
+        function_block_pos, language_mode(), function_state_->kind(),
+        scope_->has_simple_parameters(), bookmark != nullptr);
+    if (function != NULL) {
+      if (function->aborted) {
+        // The preparser would have decided to abort here as well.
+        bookmark->Reset();
+        return;
+      }
+      unsigned backing[FunctionEntry::kSize];
+      backing[FunctionEntry::kStartPositionIndex] = function_block_pos;
+      backing[FunctionEntry::kEndPositionIndex] = function->end_position;
+      backing[FunctionEntry::kLiteralCountIndex] = function->literal_count;
+      backing[FunctionEntry::kPropertyCountIndex] = function->property_count;
+      backing[FunctionEntry::kLanguageModeIndex] =
+          function->result_language_mode;
+      backing[FunctionEntry::kUsesSuperPropertyIndex] =
+          function->uses_super_property;
+      backing[FunctionEntry::kCallsEvalIndex] = function->calls_eval;
+      SkipPreParsedFunctionBody(
+          FunctionEntry(Vector<unsigned>(backing, FunctionEntry::kSize)),
+          function_block_pos, materialized_literal_count,
+          expected_property_count, ok);
+      if (!*ok) return;
+      if (retain_preparse_data_) {
+        preparse_data_recorder_.LogFunctions(function->inner_entries);
+      }
+      LogSkippedFunctionBody(function_block_pos, *materialized_literal_count,
+                             *expected_property_count);
+      return;
+    }
+  }
   if (consume_cached_parse_data() && !cached_parse_data_->rejected()) {
     // If we have cached data, we use it to skip parsing the function body. The
     // data contains the information we need to construct the lazy function.
@@ -4504,19 +4602,9 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
     // handles it). Note that end position greater than end of stream is safe,
     // and hard to check.
     if (entry.is_valid() && entry.end_pos() > function_block_pos) {
-      scanner()->SeekForward(entry.end_pos() - 1);
-
-      scope_->set_end_position(entry.end_pos());
-      Expect(Token::RBRACE, ok);
-      if (!*ok) {
-        return;
-      }
-      total_preparse_skipped_ += scope_->end_position() - function_block_pos;
-      *materialized_literal_count = entry.literal_count();
-      *expected_property_count = entry.property_count();
-      SetLanguageMode(scope_, entry.language_mode());
-      if (entry.uses_super_property()) scope_->RecordSuperPropertyUsage();
-      if (entry.calls_eval()) scope_->RecordEvalCall();
+      SkipPreParsedFunctionBody(entry, function_block_pos,
+                                materialized_literal_count,
+                                expected_property_count, ok);
       return;
     }
     cached_parse_data_->Reject();
@@ -4557,14 +4645,103 @@ void Parser::SkipLazyFunctionBody(int* materialized_literal_count,
   if (logger.calls_eval()) {
     scope_->RecordEvalCall();
   }
+  LogSkippedFunctionBody(function_block_pos, *materialized_literal_count,
+                         *expected_property_count);
+}
+
+
+void Parser::SkipPreParsedFunctionBody(FunctionEntry entry,
+                                       int function_block_pos,
+                                       int* materialized_literal_count,
+                                       int* expected_property_count,
+                                       bool* ok) {
+  scanner()->SeekForward(entry.end_pos() - 1);
+
+  scope_->set_end_position(entry.end_pos());
+  Expect(Token::RBRACE, ok);
+  if (!*ok) {
+    return;
+  }
+  total_preparse_skipped_ += scope_->end_position() - function_block_pos;
+  *materialized_literal_count = entry.literal_count();
+  *expected_property_count = entry.property_count();
+  SetLanguageMode(scope_, entry.language_mode());
+  if (entry.uses_super_property()) scope_->RecordSuperPropertyUsage();
+  if (entry.calls_eval()) scope_->RecordEvalCall();
+}
+
+
+void Parser::LogSkippedFunctionBody(int function_block_pos,
+                                    int materialized_literal_count,
+                                    int expected_property_count) {
+  // Position right after terminal '}'.
+  int body_end = scanner()->location().end_pos;
   if (produce_cached_parse_data()) {
     DCHECK(log_);
-    // Position right after terminal '}'.
-    int body_end = scanner()->location().end_pos;
-    log_->LogFunction(function_block_pos, body_end, *materialized_literal_count,
-                      *expected_property_count, scope_->language_mode(),
+    log_->LogFunction(function_block_pos, body_end, materialized_literal_count,
+                      expected_property_count, scope_->language_mode(),
                       scope_->uses_super_property(), scope_->calls_eval());
   }
+  if (retain_preparse_data_) {
+    preparse_data_recorder_.LogFunction(
+        function_block_pos, body_end, materialized_literal_count,
+        expected_property_count, scope_->language_mode(),
+        scope_->uses_super_property(), scope_->calls_eval());
+  }
+}
+
+
+void Parser::LoadPreparseData(ByteArray* preparse_data, int start_position,
+                              int end_position) {
+  const unsigned* data =
+      reinterpret_cast<const unsigned*>(preparse_data->GetDataStartAddress());
+  int count = preparse_data->length() /
+              static_cast<int>(FunctionEntry::kSize * sizeof(unsigned));
+  // Find the first function that starts after {start_position}.
+  int low = 0;
+  int high = count;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    int start = data[mid * FunctionEntry::kSize +
+                     FunctionEntry::kStartPositionIndex];
+    if (start <= start_position) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  for (int i = low; i < count; i++) {
+    const unsigned* entry = data + i * FunctionEntry::kSize;
+    if (static_cast<int>(entry[FunctionEntry::kStartPositionIndex]) >=
+        end_position) {
+      break;
+    }
+    // Skip the entry of the function itself, which ends where it does.
+    if (static_cast<int>(entry[FunctionEntry::kEndPositionIndex]) >=
+        end_position) {
+      continue;
+    }
+    for (int j = 0; j < FunctionEntry::kSize; j++) preparse_data_.Add(entry[j]);
+  }
+}
+
+
+FunctionEntry Parser::LookupPreparseData(int start) {
+  int low = 0;
+  int high = preparse_data_.length() / FunctionEntry::kSize;
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+    unsigned* entry = &preparse_data_[mid * FunctionEntry::kSize];
+    int entry_start = entry[FunctionEntry::kStartPositionIndex];
+    if (entry_start == start) {
+      return FunctionEntry(Vector<unsigned>(entry, FunctionEntry::kSize));
+    } else if (entry_start < start) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return FunctionEntry();
 }
 
 
@@ -4828,6 +5005,27 @@ ZoneList<Statement*>* Parser::ParseEagerFunctionBody(
 }
 
 
+PreParser* Parser::NewPreParser(Zone* zone, Scanner* scanner,
+                                AstValueFactory* ast_value_factory,
+                                uintptr_t stack_limit) {
+  PreParser* preparser =
+      new PreParser(zone, scanner, ast_value_factory, NULL, stack_limit);
+  preparser->set_allow_lazy(true);
+#define SET_ALLOW(name) preparser->set_allow_##name(allow_##name());
+  SET_ALLOW(natives);
+  SET_ALLOW(harmony_sloppy);
+  SET_ALLOW(harmony_sloppy_let);
+  SET_ALLOW(harmony_default_parameters);
+  SET_ALLOW(harmony_destructuring_bind);
+  SET_ALLOW(harmony_destructuring_assignment);
+  SET_ALLOW(strong_mode);
+  SET_ALLOW(harmony_do_expressions);
+  SET_ALLOW(harmony_function_name);
+#undef SET_ALLOW
+  return preparser;
+}
+
+
 PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
     SingletonLogger* logger, Scanner::BookmarkScope* bookmark) {
   // This function may be called on a background thread too; record only the
@@ -4838,21 +5036,11 @@ PreParser::PreParseResult Parser::ParseLazyFunctionBodyWithPreParser(
   DCHECK_EQ(Token::LBRACE, scanner()->current_token());
 
   if (reusable_preparser_ == NULL) {
-    reusable_preparser_ = new PreParser(zone(), &scanner_, ast_value_factory(),
-                                        NULL, stack_limit_);
-    reusable_preparser_->set_allow_lazy(true);
-#define SET_ALLOW(name) reusable_preparser_->set_allow_##name(allow_##name());
-    SET_ALLOW(natives);
-    SET_ALLOW(harmony_sloppy);
-    SET_ALLOW(harmony_sloppy_let);
-    SET_ALLOW(harmony_default_parameters);
-    SET_ALLOW(harmony_destructuring_bind);
-    SET_ALLOW(harmony_destructuring_assignment);
-    SET_ALLOW(strong_mode);
-    SET_ALLOW(harmony_do_expressions);
-    SET_ALLOW(harmony_function_name);
-#undef SET_ALLOW
+    reusable_preparser_ =
+        NewPreParser(zone(), &scanner_, ast_value_factory(), stack_limit_);
   }
+  reusable_preparser_->set_inner_function_log(
+      retain_preparse_data_ ? &preparse_data_recorder_ : NULL);
   PreParser::PreParseResult result = reusable_preparser_->PreParseLazyFunction(
       language_mode(), function_state_->kind(), scope_->has_simple_parameters(),
       logger, bookmark);
@@ -5189,6 +5377,16 @@ void Parser::Internalize(Isolate* isolate, Handle<Script> script, bool error) {
   }
   isolate->counters()->total_preparse_skipped()->Increment(
       total_preparse_skipped_);
+  isolate->counters()->retained_preparse_skipped()->Increment(
+      retained_preparse_skipped_);
+
+  // Keep the preparse data for lazy compilation. Later parses of the script
+  // only use the data.
+  if (retain_preparse_data_ && !error && !preparse_data_recorder_.is_empty() &&
+      !script.is_null() && script->preparse_data()->IsUndefined()) {
+    script->set_preparse_data(
+        *preparse_data_recorder_.GetPreparseData(isolate));
+  }
 }
 
 
@@ -911,6 +911,8 @@ class ParserTraits {
 };
 
 
+class ParallelPreParser;
+
 class Parser : public ParserBase<ParserTraits> {
  public:
   explicit Parser(ParseInfo* info);
@@ -1224,9 +1226,27 @@ class Parser : public ParserBase<ParserTraits> {
                             int* expected_property_count, bool* ok,
                             Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Skips a function body that has been preparsed already, as described by
+  // {entry}. Consumes the ending }.
+  void SkipPreParsedFunctionBody(FunctionEntry entry, int function_block_pos,
+                                 int* materialized_literal_count,
+                                 int* expected_property_count, bool* ok);
+  // Logs a function body that was skipped after preparsing it.
+  void LogSkippedFunctionBody(int function_block_pos,
+                              int materialized_literal_count,
+                              int expected_property_count);
+
   PreParser::PreParseResult ParseLazyFunctionBodyWithPreParser(
       SingletonLogger* logger, Scanner::BookmarkScope* bookmark = nullptr);
 
+  // Loads the entries of the script's preparse data that lie in the function
+  // being compiled lazily.
+  void LoadPreparseData(ByteArray* preparse_data, int start_position,
+                        int end_position);
+  // Returns the loaded entry for the function body starting at {start}, or an
+  // invalid entry.
+  FunctionEntry LookupPreparseData(int start);
+
   Block* BuildParameterInitializationBlock(
       const ParserFormalParameters& parameters, bool* ok);
 
@@ -1261,12 +1281,30 @@ class Parser : public ParserBase<ParserTraits> {
   friend class InitializerRewriter;
   void RewriteParameterInitializer(Expression* expr, Scope* scope);
 
+  // Creates a preparser for lazy function bodies with the language features
+  // of this parser.
+  friend class ParallelPreParser;
+  PreParser* NewPreParser(Zone* zone, Scanner* scanner,
+                          AstValueFactory* ast_value_factory,
+                          uintptr_t stack_limit);
+
   Scanner scanner_;
   PreParser* reusable_preparser_;
   Scope* original_scope_;  // for ES5 function declarations in sloppy eval
   Target* target_stack_;  // for break, continue statements
   ScriptCompiler::CompileOptions compile_options_;
   ParseData* cached_parse_data_;
+  ParallelPreParser* parallel_preparser_;
+
+  // The functions skipped after preparsing, to be kept by the script.
+  PreparseDataRecorder preparse_data_recorder_;
+  // The entries of the script's preparse data for the function being compiled
+  // lazily, sorted by start position.
+  List<unsigned> preparse_data_;
+  // Whether the script keeps the preparse data recorded by this parse.
+  bool retain_preparse_data_;
+  // The number of inner functions skipped with the script's preparse data.
+  int retained_preparse_skipped_;
 
   PendingCompilationErrorHandler pending_error_handler_;
 
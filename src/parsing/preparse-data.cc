@@ -2,7 +2,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+
 #include "src/base/logging.h"
+#include "src/factory.h"
 #include "src/globals.h"
 #include "src/hashmap.h"
 #include "src/parsing/parser.h"
@@ -76,5 +79,37 @@ ScriptData* CompleteParserRecorder::GetScriptData() {
 }
 
 
+Handle<ByteArray> PreparseDataRecorder::GetPreparseData(Isolate* isolate) {
+  const int kSize = FunctionEntry::kSize;
+  const unsigned* store = function_store_.begin();
+  int count = function_store_.length() / kSize;
+  List<int> order(count);
+  for (int i = 0; i < count; i++) order.Add(i);
+  std::sort(order.begin(), order.end(), [store](int a, int b) {
+    return store[a * kSize + FunctionEntry::kStartPositionIndex] <
+           store[b * kSize + FunctionEntry::kStartPositionIndex];
+  });
+  // A function is recorded once for every time it is skipped, e.g. when the
+  // parser retries a body that it started to preparse.
+  List<int> unique(count);
+  for (int i = 0; i < count; i++) {
+    if (!unique.is_empty() &&
+        store[unique.last() * kSize + FunctionEntry::kStartPositionIndex] ==
+            store[order[i] * kSize + FunctionEntry::kStartPositionIndex]) {
+      continue;
+    }
+    unique.Add(order[i]);
+  }
+  Handle<ByteArray> result = isolate->factory()->NewByteArray(
+      unique.length() * kSize * sizeof(unsigned), TENURED);
+  unsigned* data = reinterpret_cast<unsigned*>(result->GetDataStartAddress());
+  for (int i = 0; i < unique.length(); i++) {
+    MemCopy(data + i * kSize, store + unique[i] * kSize,
+            kSize * sizeof(unsigned));
+  }
+  return result;
+}
+
+
 }  // namespace internal
 }  // namespace v8.
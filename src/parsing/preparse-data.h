@@ -26,6 +26,12 @@ class ScriptData {
 
   void Reject() { rejected_ = true; }
 
+  // A code cache is prechecked if all checks that do not depend on the
+  // source string have already passed off the main thread.
+  bool prechecked() const { return prechecked_; }
+
+  void MarkPrechecked() { prechecked_ = true; }
+
   void AcquireDataOwnership() {
     DCHECK(!owns_data_);
     owns_data_ = true;
@@ -39,6 +45,7 @@ class ScriptData {
  private:
   bool owns_data_ : 1;
   bool rejected_ : 1;
+  bool prechecked_ : 1;
   const byte* data_;
   int length_;
 
@@ -206,6 +213,48 @@ class CompleteParserRecorder : public ParserRecorder {
 };
 
 
+// Records the functions the preparser skips, in the layout of FunctionEntry,
+// so that a script can keep them for when the functions that contain them are
+// compiled lazily (see Script::preparse_data).
+class PreparseDataRecorder : public ParserRecorder {
+ public:
+  PreparseDataRecorder() {}
+  virtual ~PreparseDataRecorder() {}
+
+  virtual void LogFunction(int start, int end, int literals, int properties,
+                           LanguageMode language_mode, bool uses_super_property,
+                           bool calls_eval) {
+    function_store_.Add(start);
+    function_store_.Add(end);
+    function_store_.Add(literals);
+    function_store_.Add(properties);
+    function_store_.Add(language_mode);
+    function_store_.Add(uses_super_property);
+    function_store_.Add(calls_eval);
+  }
+
+  // Errors are reported through the log of the parser.
+  virtual void LogMessage(int start, int end, MessageTemplate::Template message,
+                          const char* argument_opt, ParseErrorType error_type) {
+  }
+
+  // Appends entries recorded by another recorder.
+  void LogFunctions(Vector<unsigned> entries) {
+    function_store_.AddAll(entries);
+  }
+
+  bool is_empty() const { return function_store_.is_empty(); }
+  Vector<unsigned> entries() const { return function_store_.ToVector(); }
+  void Clear() { function_store_.Clear(); }
+
+  // Returns the entries sorted by start position, without duplicates.
+  Handle<ByteArray> GetPreparseData(Isolate* isolate);
+
+ private:
+  List<unsigned> function_store_;
+};
+
+
 }  // namespace internal
 }  // namespace v8.
 
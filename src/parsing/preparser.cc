@@ -217,7 +217,8 @@ void PreParser::ParseStatementList(int end_token, bool* ok,
 
   // Bookkeeping for trial parse if bookmark is set:
   DCHECK_IMPLIES(bookmark, bookmark->HasBeenSet());
-  bool maybe_reset = bookmark != nullptr;
+  bool maybe_long_and_trivial = true;
+  bool long_and_trivial = false;
   int count_statements = 0;
 
   bool directive_prologue = true;
@@ -293,15 +294,20 @@ void PreParser::ParseStatementList(int end_token, bool* ok,
     // Our current definition of 'long and trivial' is:
     // - over 200 statements
     // - all starting with an identifier (i.e., no if, for, while, etc.)
-    if (maybe_reset && (!starts_with_identifier ||
-                        ++count_statements > kLazyParseTrialLimit)) {
+    if (maybe_long_and_trivial &&
+        (!starts_with_identifier ||
+         ++count_statements > kLazyParseTrialLimit)) {
       if (count_statements > kLazyParseTrialLimit) {
-        bookmark->Reset();
-        return;
+        if (bookmark != nullptr) {
+          bookmark->Reset();
+          return;
+        }
+        long_and_trivial = true;
       }
-      maybe_reset = false;
+      maybe_long_and_trivial = false;
     }
   }
+  long_and_trivial_body_ = long_and_trivial;
 }
 
 
@@ -1132,12 +1138,21 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
   parenthesized_function_ = false;
 
   Expect(Token::LBRACE, CHECK_OK);
+  int body_start = position();
+  int literals_before_body = function_state.materialized_literal_count();
+  int properties_before_body = function_state.expected_property_count();
+  bool log_inner_function = false;
   if (is_lazily_parsed) {
     ParseLazyFunctionLiteralBody(CHECK_OK);
   } else {
     ParseStatementList(Token::RBRACE, CHECK_OK);
+    // The parser gives up on preparsing long and trivial functions, so they
+    // must not be skipped with the inner function log either.
+    log_inner_function =
+        inner_function_log_ != NULL && !long_and_trivial_body_;
   }
   Expect(Token::RBRACE, CHECK_OK);
+  int body_end = scanner()->location().end_pos;
 
   // Parsing the body may change the language mode in our scope.
   language_mode = function_scope->language_mode();
@@ -1166,6 +1181,15 @@ PreParser::Expression PreParser::ParseFunctionLiteral(
     }
   }
 
+  if (log_inner_function) {
+    inner_function_log_->LogFunction(
+        body_start, body_end,
+        function_state.materialized_literal_count() - literals_before_body,
+        function_state.expected_property_count() - properties_before_body,
+        language_mode, function_scope->uses_super_property(),
+        function_scope->calls_eval());
+  }
+
   return Expression::Default();
 }
 
@@ -954,7 +954,9 @@ class PreParser : public ParserBase<PreParserTraits> {
   PreParser(Zone* zone, Scanner* scanner, AstValueFactory* ast_value_factory,
             ParserRecorder* log, uintptr_t stack_limit)
       : ParserBase<PreParserTraits>(zone, scanner, stack_limit, NULL,
-                                    ast_value_factory, log, this) {}
+                                    ast_value_factory, log, this),
+        inner_function_log_(NULL),
+        long_and_trivial_body_(false) {}
 
   // Pre-parse the program from the character stream; returns true on
   // success (even if parsing failed, the pre-parse data successfully
@@ -993,6 +995,12 @@ class PreParser : public ParserBase<PreParserTraits> {
       LanguageMode language_mode, FunctionKind kind, bool has_simple_parameters,
       ParserRecorder* log, Scanner::BookmarkScope* bookmark = nullptr);
 
+  // If set, the functions nested in a lazily preparsed function are logged to
+  // {log} as well, except for arrow functions and long and trivial functions.
+  void set_inner_function_log(ParserRecorder* log) {
+    inner_function_log_ = log;
+  }
+
  private:
   friend class PreParserTraits;
 
@@ -1061,6 +1069,10 @@ class PreParser : public ParserBase<PreParserTraits> {
                                         Scanner::Location class_name_location,
                                         bool name_is_strict_reserved, int pos,
                                         bool* ok);
+
+  ParserRecorder* inner_function_log_;
+  // Whether the last statement list was a long and trivial function body.
+  bool long_and_trivial_body_;
 };
 
 
@@ -131,7 +131,18 @@ size_t BufferedUtf16CharacterStream::SlowSeekForward(size_t delta) {
 
 GenericStringUtf16CharacterStream::GenericStringUtf16CharacterStream(
     Handle<String> data, size_t start_position, size_t end_position)
-    : string_(data), length_(end_position), bookmark_(kNoBookmark) {
+    : string_(data),
+      one_byte_chars_(NULL),
+      length_(end_position),
+      bookmark_(kNoBookmark) {
+  DCHECK(end_position >= start_position);
+  pos_ = start_position;
+}
+
+
+GenericStringUtf16CharacterStream::GenericStringUtf16CharacterStream(
+    const uint8_t* data, size_t start_position, size_t end_position)
+    : one_byte_chars_(data), length_(end_position), bookmark_(kNoBookmark) {
   DCHECK(end_position >= start_position);
   pos_ = start_position;
 }
@@ -168,6 +179,10 @@ size_t GenericStringUtf16CharacterStream::FillBuffer(size_t from_pos) {
   if (from_pos + length > length_) {
     length = length_ - from_pos;
   }
+  if (one_byte_chars_ != NULL) {
+    CopyChars(buffer_, one_byte_chars_ + from_pos, length);
+    return length;
+  }
   String::WriteToFlat<uc16>(*string_, buffer_, static_cast<int>(from_pos),
                             static_cast<int>(from_pos + length));
   return length;
@@ -202,11 +217,19 @@ size_t Utf8ToUtf16CharacterStream::CopyChars(uint16_t* dest, size_t length,
     if (*src_pos == src_length) break;
     unibrow::uchar c = src[*src_pos];
     if (c <= unibrow::Utf8::kMaxOneByteChar) {
-      *src_pos = *src_pos + 1;
-    } else {
-      c = unibrow::Utf8::CalculateValue(src + *src_pos, src_length - *src_pos,
-                                        src_pos);
+      // Copy the run of ASCII characters that starts here at once.
+      size_t run = Min(length - 1 - i, src_length - *src_pos);
+      run = Max(1, String::NonAsciiStart(
+                       reinterpret_cast<const char*>(src + *src_pos),
+                       static_cast<int>(run)));
+      v8::internal::CopyChars<uint8_t, uint16_t>(dest + i, src + *src_pos,
+                                                 run);
+      *src_pos += run;
+      i += run;
+      continue;
     }
+    c = unibrow::Utf8::CalculateValue(src + *src_pos, src_length - *src_pos,
+                                      src_pos);
     if (c > kMaxUtf16Character) {
       dest[i++] = unibrow::Utf16::LeadSurrogate(c);
       dest[i++] = unibrow::Utf16::TrailSurrogate(c);
@@ -584,5 +607,31 @@ void ExternalTwoByteStringUtf16CharacterStream::ResetToBookmark() {
   pos_ = bookmark_;
   buffer_cursor_ = raw_data_ + bookmark_;
 }
+
+
+TwoByteBufferUtf16CharacterStream::TwoByteBufferUtf16CharacterStream(
+    const uc16* data, int start_position, int end_position)
+    : Utf16CharacterStream(), data_(data), bookmark_(kNoBookmark) {
+  buffer_cursor_ = data_ + start_position;
+  buffer_end_ = data_ + end_position;
+  pos_ = start_position;
+}
+
+
+TwoByteBufferUtf16CharacterStream::~TwoByteBufferUtf16CharacterStream() {}
+
+
+bool TwoByteBufferUtf16CharacterStream::SetBookmark() {
+  bookmark_ = pos_;
+  return true;
+}
+
+
+void TwoByteBufferUtf16CharacterStream::ResetToBookmark() {
+  DCHECK(bookmark_ != kNoBookmark);
+  pos_ = bookmark_;
+  buffer_cursor_ = data_ + bookmark_;
+}
+
 }  // namespace internal
 }  // namespace v8
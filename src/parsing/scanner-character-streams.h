@@ -46,6 +46,10 @@ class GenericStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
  public:
   GenericStringUtf16CharacterStream(Handle<String> data, size_t start_position,
                                     size_t end_position);
+  // Reads one-byte characters that are not on the heap. {data} is the
+  // character at position 0, not at the start position.
+  GenericStringUtf16CharacterStream(const uint8_t* data, size_t start_position,
+                                    size_t end_position);
   ~GenericStringUtf16CharacterStream() override;
 
   bool SetBookmark() override;
@@ -58,6 +62,7 @@ class GenericStringUtf16CharacterStream: public BufferedUtf16CharacterStream {
   size_t FillBuffer(size_t position) override;
 
   Handle<String> string_;
+  const uint8_t* one_byte_chars_;
   size_t length_;
   size_t bookmark_;
 };
@@ -183,6 +188,42 @@ class ExternalTwoByteStringUtf16CharacterStream: public Utf16CharacterStream {
   size_t bookmark_;
 };
 
+
+// UTF16 buffer to read characters from a two-byte character array that is
+// not on the heap, so that it can be scanned on a background thread.
+class TwoByteBufferUtf16CharacterStream : public Utf16CharacterStream {
+ public:
+  TwoByteBufferUtf16CharacterStream(const uc16* data, int start_position,
+                                    int end_position);
+  ~TwoByteBufferUtf16CharacterStream() override;
+
+  void PushBack(uc32 character) override {
+    DCHECK(buffer_cursor_ > data_);
+    buffer_cursor_--;
+    pos_--;
+  }
+
+  bool SetBookmark() override;
+  void ResetToBookmark() override;
+
+ protected:
+  size_t SlowSeekForward(size_t delta) override {
+    // Fast case always handles seeking.
+    return 0;
+  }
+  bool ReadBlock() override {
+    // Entire buffer is read at start.
+    return false;
+  }
+  const uc16* data_;  // Character at position 0, not at the start position.
+
+ private:
+  static const size_t kNoBookmark = -1;
+
+  size_t bookmark_;
+};
+
+
 }  // namespace internal
 }  // namespace v8
 
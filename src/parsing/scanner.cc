@@ -33,6 +33,81 @@ bool Utf16CharacterStream::SetBookmark() { return false; }
 void Utf16CharacterStream::ResetToBookmark() { UNREACHABLE(); }
 
 
+// ----------------------------------------------------------------------------
+// Classification of runs of code units
+
+namespace {
+
+// The scanner skips runs of identifier characters, blanks and the bodies of
+// comments and strings a word at a time, see CharLanes. Only ASCII code units
+// are classified a word at a time.
+typedef CharLanes<uint16_t> CodeUnitLanes;
+
+inline uintptr_t LanesInRange(uintptr_t word, uc16 lo, uc16 hi) {
+  return CodeUnitLanes::InRange(word, lo, hi);
+}
+
+
+struct IdentifierPartCharacters {
+  static const bool kAcceptsNonAscii = false;
+  bool Contains(uc16 c) const { return IsAsciiIdentifier(c); }
+  uintptr_t Lanes(uintptr_t word) const {
+    return LanesInRange(word | (CodeUnitLanes::kOnes * 0x20), 'a', 'z') |
+           LanesInRange(word, '0', '9') | LanesInRange(word, '_', '_') |
+           LanesInRange(word, '$', '$');
+  }
+};
+
+
+struct BlankCharacters {
+  static const bool kAcceptsNonAscii = false;
+  bool Contains(uc16 c) const { return c == ' ' || c == '\t'; }
+  uintptr_t Lanes(uintptr_t word) const {
+    return LanesInRange(word, ' ', ' ') | LanesInRange(word, '\t', '\t');
+  }
+};
+
+
+// Printable ASCII characters and tabs, which are never line terminators.
+struct SingleLineCommentCharacters {
+  static const bool kAcceptsNonAscii = false;
+  bool Contains(uc16 c) const { return IsInRange(c, ' ', 0x7F) || c == '\t'; }
+  uintptr_t Lanes(uintptr_t word) const {
+    return LanesInRange(word, ' ', 0x7F) | LanesInRange(word, '\t', '\t');
+  }
+};
+
+
+struct MultiLineCommentCharacters {
+  static const bool kAcceptsNonAscii = false;
+  bool Contains(uc16 c) const {
+    return SingleLineCommentCharacters().Contains(c) && c != '*';
+  }
+  uintptr_t Lanes(uintptr_t word) const {
+    return SingleLineCommentCharacters().Lanes(word) &
+           ~LanesInRange(word, '*', '*');
+  }
+};
+
+
+// Printable ASCII characters other than the quote and the backslash.
+struct StringCharacters {
+  static const bool kAcceptsNonAscii = false;
+  explicit StringCharacters(uc16 quote) : quote(quote) {}
+  bool Contains(uc16 c) const {
+    return IsInRange(c, ' ', 0x7F) && c != quote && c != '\\';
+  }
+  uintptr_t Lanes(uintptr_t word) const {
+    return LanesInRange(word, ' ', 0x7F) &
+           ~(LanesInRange(word, quote, quote) |
+             LanesInRange(word, '\\', '\\'));
+  }
+  uc16 quote;
+};
+
+}  // namespace
+
+
 // ----------------------------------------------------------------------------
 // Scanner
 
@@ -287,6 +362,20 @@ static inline bool IsLittleEndianByteOrderMark(uc32 c) {
 }
 
 
+template <bool add_literal, bool check_surrogate, typename Classifier>
+void Scanner::AdvanceRun(const Classifier& classifier) {
+  if (add_literal) AddLiteralChar(c0_);
+  Vector<const uint16_t> chars = source_->buffered_code_units();
+  int length =
+      CodeUnitLanes::RunLength(classifier, chars.start(), chars.length());
+  if (length > 0) {
+    if (add_literal) next_.literal_chars->AddAsciiChars(chars.start(), length);
+    source_->SeekForward(length);
+  }
+  Advance<false, check_surrogate>();
+}
+
+
 bool Scanner::SkipWhiteSpace() {
   int start_position = source_pos();
 
@@ -302,7 +391,8 @@ bool Scanner::SkipWhiteSpace() {
                  !IsLittleEndianByteOrderMark(c0_)) {
         break;
       }
-      Advance();
+      // Skip the blanks that follow at once, e.g. indentation.
+      AdvanceRun<false, true>(BlankCharacters());
     }
 
     // If there is an HTML comment end '-->' at the beginning of a
@@ -338,7 +428,7 @@ Token::Value Scanner::SkipSingleLineComment() {
   // stream of input elements for the syntactic grammar (see
   // ECMA-262, section 7.4).
   while (c0_ >= 0 && !unicode_cache_->IsLineTerminator(c0_)) {
-    Advance();
+    AdvanceRun<false, true>(SingleLineCommentCharacters());
   }
 
   return Token::WHITESPACE;
@@ -412,6 +502,10 @@ Token::Value Scanner::SkipMultiLineComment() {
 
   while (c0_ >= 0) {
     uc32 ch = c0_;
+    if (ch != '*' && !unicode_cache_->IsLineTerminator(ch)) {
+      AdvanceRun<false, true>(MultiLineCommentCharacters());
+      continue;
+    }
     Advance();
     if (c0_ >= 0 && unicode_cache_->IsLineTerminator(ch)) {
       // Following ECMA-262, section 7.4, a comment containing
@@ -832,10 +926,8 @@ Token::Value Scanner::ScanString() {
       Advance<false, false>();
       return Token::STRING;
     }
-    uc32 c = c0_;
-    if (c == '\\') break;
-    Advance<false, false>();
-    AddLiteralChar(c);
+    if (c0_ == '\\') break;
+    AdvanceRun<true, false>(StringCharacters(quote));
   }
 
   while (c0_ != quote && c0_ >= 0
@@ -1245,14 +1337,9 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     if (IsDecimalDigit(c0_) || IsInRange(c0_, 'A', 'Z') || c0_ == '_' ||
         c0_ == '$') {
       // Identifier starting with lowercase.
-      uc32 first_char = c0_;
-      Advance<false, false>();
-      AddLiteralChar(first_char);
-      while (IsAsciiIdentifier(c0_)) {
-        uc32 first_char = c0_;
-        Advance<false, false>();
-        AddLiteralChar(first_char);
-      }
+      do {
+        AdvanceRun<true, false>(IdentifierPartCharacters());
+      } while (IsAsciiIdentifier(c0_));
       if (c0_ <= kMaxAscii && c0_ != '\\') {
         literal.Complete();
         return Token::IDENTIFIER;
@@ -1267,9 +1354,7 @@ Token::Value Scanner::ScanIdentifierOrKeyword() {
     HandleLeadSurrogate();
   } else if (IsInRange(c0_, 'A', 'Z') || c0_ == '_' || c0_ == '$') {
     do {
-      uc32 first_char = c0_;
-      Advance<false, false>();
-      AddLiteralChar(first_char);
+      AdvanceRun<true, false>(IdentifierPartCharacters());
     } while (IsAsciiIdentifier(c0_));
 
     if (c0_ <= kMaxAscii && c0_ != '\\') {
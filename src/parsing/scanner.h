@@ -84,6 +84,14 @@ class Utf16CharacterStream {
     return SlowSeekForward(code_unit_count);
   }
 
+  // Returns the code units that are buffered after the current position, so
+  // that the scanner can classify runs of them at once and then skip them
+  // with SeekForward.
+  inline Vector<const uint16_t> buffered_code_units() const {
+    return Vector<const uint16_t>(
+        buffer_cursor_, static_cast<int>(buffer_end_ - buffer_cursor_));
+  }
+
   // Pushes back the most recently read UTF-16 code unit (or negative
   // value if at end of input), i.e., the value returned by the most recent
   // call to Advance.
@@ -192,6 +200,25 @@ class LiteralBuffer {
     }
   }
 
+  // Adds a run of ASCII code units.
+  void AddAsciiChars(const uint16_t* code_units, int count) {
+    if (count == 0) return;
+    int size = is_one_byte_ ? count * kOneByteSize : count * kUC16Size;
+    if (position_ + size > backing_store_.length()) {
+      ExpandBuffer(position_ + size);
+    }
+    if (is_one_byte_) {
+      byte* dest = &backing_store_[position_];
+      for (int i = 0; i < count; i++) {
+        DCHECK(code_units[i] <= unibrow::Utf8::kMaxOneByteChar);
+        dest[i] = static_cast<byte>(code_units[i]);
+      }
+    } else {
+      MemCopy(&backing_store_[position_], code_units, size);
+    }
+    position_ += size;
+  }
+
   bool is_one_byte() const { return is_one_byte_; }
 
   bool is_contextual_keyword(Vector<const char> keyword) const {
@@ -251,8 +278,8 @@ class LiteralBuffer {
     return new_capacity;
   }
 
-  void ExpandBuffer() {
-    Vector<byte> new_store = Vector<byte>::New(NewCapacity(kInitialCapacity));
+  void ExpandBuffer(int min_capacity = kInitialCapacity) {
+    Vector<byte> new_store = Vector<byte>::New(NewCapacity(min_capacity));
     MemCopy(new_store.start(), backing_store_.start(), position_);
     backing_store_.Dispose();
     backing_store_ = new_store;
@@ -650,6 +677,12 @@ class Scanner {
   // Scans a single JavaScript token.
   void Scan();
 
+  // Advances past c0_, which the caller has checked, and the run of buffered
+  // code units after it that are in the class of {classifier}. Adds them to
+  // the literal if {add_literal}.
+  template <bool add_literal, bool check_surrogate, typename Classifier>
+  void AdvanceRun(const Classifier& classifier);
+
   bool SkipWhiteSpace();
   Token::Value SkipSingleLineComment();
   Token::Value SkipSourceURLComment();
@@ -516,9 +516,11 @@ void CpuProfiler::LogBuiltins() {
   Builtins* builtins = isolate_->builtins();
   DCHECK(builtins->is_initialized());
   for (int i = 0; i < Builtins::builtin_count; i++) {
+    Builtins::Name id = static_cast<Builtins::Name>(i);
+    // Lazy builtins are reported when they are deserialized.
+    if (!builtins->is_deserialized(id)) continue;
     CodeEventsContainer evt_rec(CodeEventRecord::REPORT_BUILTIN);
     ReportBuiltinEventRecord* rec = &evt_rec.ReportBuiltinEventRecord_;
-    Builtins::Name id = static_cast<Builtins::Name>(i);
     rec->start = builtins->builtin(id)->address();
     rec->builtin_id = id;
     processor_->Enqueue(evt_rec);
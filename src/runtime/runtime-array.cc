@@ -33,7 +33,7 @@ RUNTIME_FUNCTION(Runtime_FinishArrayPrototypeSetup) {
 static void InstallBuiltin(Isolate* isolate, Handle<JSObject> holder,
                            const char* name, Builtins::Name builtin_name) {
   Handle<String> key = isolate->factory()->InternalizeUtf8String(name);
-  Handle<Code> code(isolate->builtins()->builtin(builtin_name));
+  Handle<Code> code = isolate->builtins()->builtin_handle(builtin_name);
   Handle<JSFunction> optimized =
       isolate->factory()->NewFunctionWithoutPrototype(key, code);
   optimized->shared()->DontAdaptArguments();
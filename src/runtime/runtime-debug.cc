@@ -1460,6 +1460,7 @@ RUNTIME_FUNCTION(Runtime_DebugSetScriptSource) {
   int compilation_state = script->compilation_state();
   RUNTIME_ASSERT(compilation_state == Script::COMPILATION_STATE_INITIAL);
   script->set_source(*source);
+  script->set_preparse_data(isolate->heap()->undefined_value());
 
   return isolate->heap()->undefined_value();
 }
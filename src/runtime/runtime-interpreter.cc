@@ -5,6 +5,7 @@
 #include "src/runtime/runtime-utils.h"
 
 #include "src/arguments.h"
+#include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 
 namespace v8 {
@@ -198,5 +199,17 @@ RUNTIME_FUNCTION(Runtime_InterpreterForInPrepare) {
   return *result;
 }
 
+
+RUNTIME_FUNCTION(Runtime_InterpreterGetDispatchCounters) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(0, args.length());
+  // The counters are only recorded if --trace-ignition-dispatches was set
+  // when the isolate was created.
+  if (isolate->interpreter()->bytecode_dispatch_counters_table() == nullptr) {
+    return isolate->heap()->undefined_value();
+  }
+  return *isolate->interpreter()->GetDispatchCountersObject();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -227,7 +227,8 @@ namespace internal {
   F(InterpreterLogicalNot, 1, 1)          \
   F(InterpreterTypeOf, 1, 1)              \
   F(InterpreterNewClosure, 2, 1)          \
-  F(InterpreterForInPrepare, 1, 1)
+  F(InterpreterForInPrepare, 1, 1)        \
+  F(InterpreterGetDispatchCounters, 0, 1)
 
 
 #define FOR_EACH_INTRINSIC_FUNCTION(F)     \
@@ -133,6 +133,8 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
       "Isolate::virtual_slot_register()");
   Add(ExternalReference::runtime_function_table_address(isolate).address(),
       "Runtime::runtime_function_table_address()");
+  Add(ExternalReference::interpreter_dispatch_counters(isolate).address(),
+      "Interpreter::dispatch_counters");
 
   // Debug addresses
   Add(ExternalReference::debug_after_break_target_address(isolate).address(),
@@ -313,6 +315,17 @@ ExternalReferenceTable::ExternalReferenceTable(Isolate* isolate) {
         Deoptimizer::CALCULATE_ENTRY_ADDRESS);
     Add(address, "lazy_deopt");
   }
+
+  // Add the external references provided by the embedder, which are given
+  // as a null-terminated array.
+  intptr_t* api_external_references = isolate->api_external_references();
+  if (api_external_references != NULL) {
+    while (*api_external_references != 0) {
+      Add(reinterpret_cast<Address>(*api_external_references),
+          "<api reference>");
+      api_external_references++;
+    }
+  }
 }
 
 
@@ -336,7 +349,12 @@ uint32_t ExternalReferenceEncoder::Encode(Address address) const {
   DCHECK_NOT_NULL(address);
   HashMap::Entry* entry =
       const_cast<HashMap*>(map_)->Lookup(address, Hash(address));
-  DCHECK_NOT_NULL(entry);
+  if (entry == NULL) {
+    // Embedder callbacks have to be registered as external references when
+    // creating the snapshot, see v8::SnapshotCreator.
+    V8_Fatal(__FILE__, __LINE__, "Unknown external reference %p.",
+             reinterpret_cast<void*>(address));
+  }
   return static_cast<uint32_t>(reinterpret_cast<intptr_t>(entry->value));
 }
 
@@ -607,6 +625,25 @@ MaybeHandle<SharedFunctionInfo> Deserializer::DeserializeCode(
 }
 
 
+MaybeHandle<Code> Deserializer::DeserializeBuiltin(Isolate* isolate) {
+  Initialize(isolate);
+  if (!ReserveSpace()) {
+    V8::FatalProcessOutOfMemory("deserialize builtin");
+    return MaybeHandle<Code>();
+  }
+
+  DisallowHeapAllocation no_gc;
+  Object* root;
+  VisitPointer(&root);
+  DeserializeDeferredObjects();
+
+  Code* code = Code::cast(root);
+  Assembler::FlushICache(isolate_, code->instruction_start(),
+                         code->instruction_size());
+  return Handle<Code>(code, isolate);
+}
+
+
 Deserializer::~Deserializer() {
   // TODO(svenpanne) Re-enable this assertion when v8 initialization is fixed.
   // DCHECK(source_.AtEOF());
@@ -729,6 +766,16 @@ HeapObject* Deserializer::PostProcessNewObject(HeapObject* obj, int space) {
     if (deserializing_user_code() || space == LO_SPACE) {
       new_code_objects_.Add(Code::cast(obj));
     }
+    // Lazy builtins may also be reachable from other objects in the startup
+    // snapshot, in which case the builtins table still has to point to them.
+    Code* code = Code::cast(obj);
+    if (!deserializing_user_code() && code->kind() == Code::BUILTIN) {
+      Builtins* builtins = isolate_->builtins();
+      Builtins::Name name = static_cast<Builtins::Name>(code->builtin_index());
+      if (!builtins->is_deserialized(name)) {
+        builtins->set_builtin(name, code);
+      }
+    }
   }
   // Check alignment.
   DCHECK_EQ(0, Heap::GetFillToAlign(obj->address(), obj->RequiredAlignment()));
@@ -1072,6 +1119,16 @@ bool Deserializer::ReadData(Object** current, Object** limit, int source_space,
       // Find an code entry in the partial snapshots cache and
       // write a pointer to it to the current object.
       SINGLE_CASE(kPartialSnapshotCache, kPlain, kInnerPointer, 0)
+#if defined(V8_TARGET_ARCH_MIPS) || defined(V8_TARGET_ARCH_MIPS64) || \
+    defined(V8_TARGET_ARCH_PPC) || V8_EMBEDDED_CONSTANT_POOL
+      // Find an object in the partial snapshots cache and write a pointer to
+      // it in code. Used by lazily deserialized builtins.
+      SINGLE_CASE(kPartialSnapshotCache, kFromCode, kStartOfObject, 0)
+#endif
+      // Find a code entry in the partial snapshots cache and write a pointer
+      // to its first instruction in code. Used by lazily deserialized
+      // builtins.
+      SINGLE_CASE(kPartialSnapshotCache, kFromCode, kInnerPointer, 0)
       // Find an external reference and write a pointer to it to the current
       // object.
       SINGLE_CASE(kExternalReference, kPlain, kStartOfObject, 0)
@@ -1430,6 +1487,8 @@ void StartupSerializer::SerializeStrongReferences() {
 
 
 void StartupSerializer::VisitPointers(Object** start, Object** end) {
+  Object** builtins_start = reinterpret_cast<Object**>(
+      isolate()->builtins()->builtin_address(static_cast<Builtins::Name>(0)));
   for (Object** current = start; current < end; current++) {
     if (start == isolate()->heap()->roots_array_start()) {
       root_index_wave_front_ =
@@ -1438,6 +1497,15 @@ void StartupSerializer::VisitPointers(Object** start, Object** end) {
     if (ShouldBeSkipped(current)) {
       sink_->Put(kSkip, "Skip");
       sink_->PutInt(kPointerSize, "SkipOneWord");
+    } else if (start == builtins_start &&
+               IsSerializedLazily(static_cast<int>(current - start))) {
+      // Leave a Smi in the builtins table, the builtin is deserialized from
+      // its own section on first use.
+      Object* placeholder = Smi::FromInt(0);
+      sink_->Put(kOnePointerRawData, "LazyBuiltin");
+      for (int i = 0; i < kPointerSize; i++) {
+        sink_->Put(reinterpret_cast<byte*>(&placeholder)[i], "Byte");
+      }
     } else if ((*current)->IsSmi()) {
       sink_->Put(kOnePointerRawData, "Smi");
       for (int i = 0; i < kPointerSize; i++) {
@@ -1540,7 +1608,7 @@ bool SerializerDeserializer::CanBeDeferred(HeapObject* o) {
 }
 
 
-int PartialSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
+int StartupSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
   Isolate* isolate = this->isolate();
   List<Object*>* cache = isolate->partial_snapshot_cache();
   int new_index = cache->length();
@@ -1551,7 +1619,7 @@ int PartialSerializer::PartialSnapshotCacheIndex(HeapObject* heap_object) {
     // then visit the pointer so that it becomes part of the startup snapshot
     // and we can refer to it from the partial snapshot.
     cache->Add(heap_object);
-    startup_serializer_->VisitPointer(reinterpret_cast<Object**>(&heap_object));
+    VisitPointer(reinterpret_cast<Object**>(&heap_object));
     // We don't recurse from the startup snapshot generator into the partial
     // snapshot generator.
     return new_index;
@@ -1568,6 +1636,7 @@ bool PartialSerializer::ShouldBeInThePartialSnapshotCache(HeapObject* o) {
   DCHECK(!o->IsScript());
   return o->IsName() || o->IsSharedFunctionInfo() || o->IsHeapNumber() ||
          o->IsCode() || o->IsScopeInfo() || o->IsExecutableAccessorInfo() ||
+         o->IsTemplateInfo() ||
          o->map() ==
              startup_serializer_->isolate()->heap()->fixed_cow_array_map();
 }
@@ -1656,8 +1725,11 @@ bool Serializer::SerializeKnownObject(HeapObject* obj, HowToCode how_to_code,
 }
 
 
-StartupSerializer::StartupSerializer(Isolate* isolate, SnapshotByteSink* sink)
-    : Serializer(isolate, sink), root_index_wave_front_(0) {
+StartupSerializer::StartupSerializer(Isolate* isolate, SnapshotByteSink* sink,
+                                     BuiltinsHandling builtins_handling)
+    : Serializer(isolate, sink),
+      root_index_wave_front_(0),
+      builtins_handling_(builtins_handling) {
   // Clear the cache of objects used by the partial snapshot.  After the
   // strong roots have been serialized we can create a partial snapshot
   // which will repopulate the cache with objects needed by that partial
@@ -1695,6 +1767,53 @@ void StartupSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
 }
 
 
+bool StartupSerializer::IsSerializedLazily(int builtin_index) {
+  if (builtins_handling_ != kSerializeBuiltinsLazily) return false;
+  if (!Builtins::IsLazy(builtin_index)) return false;
+  // Builtins that are already part of the startup snapshot, e.g. because
+  // they are referenced from a code stub, are deserialized eagerly anyway.
+  Builtins::Name name = static_cast<Builtins::Name>(builtin_index);
+  Code* code = isolate()->builtins()->builtin(name);
+  return !back_reference_map()->Lookup(code).is_valid();
+}
+
+
+void BuiltinSerializer::Serialize(Builtins::Name name) {
+  code_ = isolate()->builtins()->builtin(name);
+  Object* object = code_;
+  VisitPointer(&object);
+  SerializeDeferredObjects();
+  Pad();
+}
+
+
+void BuiltinSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
+                                        WhereToPoint where_to_point,
+                                        int skip) {
+  int root_index = root_index_map_.Lookup(obj);
+  if (root_index != RootIndexMap::kInvalidRootIndex) {
+    PutRoot(root_index, obj, how_to_code, where_to_point, skip);
+    return;
+  }
+
+  if (obj != code_ && obj != code_->relocation_info()) {
+    FlushSkip(skip);
+    int cache_index = startup_serializer_->PartialSnapshotCacheIndex(obj);
+    sink_->Put(kPartialSnapshotCache + how_to_code + where_to_point,
+               "PartialSnapshotCache");
+    sink_->PutInt(cache_index, "partial_snapshot_cache_index");
+    return;
+  }
+
+  if (SerializeKnownObject(obj, how_to_code, where_to_point, skip)) return;
+
+  FlushSkip(skip);
+
+  ObjectSerializer serializer(this, obj, sink_, how_to_code, where_to_point);
+  serializer.Serialize();
+}
+
+
 void StartupSerializer::SerializeWeakReferencesAndDeferred() {
   // This phase comes right after the serialization (of the snapshot).
   // After we have done the partial serialization the partial snapshot cache
@@ -1776,7 +1895,7 @@ void PartialSerializer::SerializeObject(HeapObject* obj, HowToCode how_to_code,
   if (ShouldBeInThePartialSnapshotCache(obj)) {
     FlushSkip(skip);
 
-    int cache_index = PartialSnapshotCacheIndex(obj);
+    int cache_index = startup_serializer_->PartialSnapshotCacheIndex(obj);
     sink_->Put(kPartialSnapshotCache + how_to_code + where_to_point,
                "PartialSnapshotCache");
     sink_->PutInt(cache_index, "partial_snapshot_cache_index");
@@ -2479,8 +2598,8 @@ void CodeSerializer::SerializeIC(Code* ic, HowToCode how_to_code,
   int builtin_index = ic->builtin_index();
   if (builtin_index < Builtins::builtin_count) {
     Builtins::Name name = static_cast<Builtins::Name>(builtin_index);
-    Code* builtin = isolate()->builtins()->builtin(name);
-    if (builtin == ic) {
+    Builtins* builtins = isolate()->builtins();
+    if (builtins->is_deserialized(name) && builtins->builtin(name) == ic) {
       if (FLAG_trace_serializer) {
         PrintF(" %s is a builtin\n", Code::Kind2String(ic->kind()));
       }
@@ -2720,8 +2839,20 @@ SerializedCodeData::SerializedCodeData(const List<byte>& payload,
 
 SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
     Isolate* isolate, String* source) const {
-  uint32_t magic_number = GetMagicNumber();
-  if (magic_number != ComputeMagicNumber(isolate)) return MAGIC_NUMBER_MISMATCH;
+  return SanityCheck(ComputeMagicNumber(isolate), FlagList::Hash(), source);
+}
+
+
+SerializedCodeData::SanityCheckResult
+SerializedCodeData::SanityCheckWithoutSource(uint32_t magic_number,
+                                             uint32_t flag_hash) const {
+  return SanityCheck(magic_number, flag_hash, NULL);
+}
+
+
+SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
+    uint32_t magic_number, uint32_t flag_hash, String* source) const {
+  if (GetMagicNumber() != magic_number) return MAGIC_NUMBER_MISMATCH;
   uint32_t version_hash = GetHeaderValue(kVersionHashOffset);
   uint32_t source_hash = GetHeaderValue(kSourceHashOffset);
   uint32_t cpu_features = GetHeaderValue(kCpuFeaturesOffset);
@@ -2729,11 +2860,13 @@ SerializedCodeData::SanityCheckResult SerializedCodeData::SanityCheck(
   uint32_t c1 = GetHeaderValue(kChecksum1Offset);
   uint32_t c2 = GetHeaderValue(kChecksum2Offset);
   if (version_hash != Version::Hash()) return VERSION_MISMATCH;
-  if (source_hash != SourceHash(source)) return SOURCE_MISMATCH;
+  if (source != NULL && source_hash != SourceHash(source)) {
+    return SOURCE_MISMATCH;
+  }
   if (cpu_features != static_cast<uint32_t>(CpuFeatures::SupportedFeatures())) {
     return CPU_FEATURES_MISMATCH;
   }
-  if (flags_hash != FlagList::Hash()) return FLAGS_MISMATCH;
+  if (flags_hash != flag_hash) return FLAGS_MISMATCH;
   if (!Checksum(Payload()).Check(c1, c2)) return CHECKSUM_MISMATCH;
   return CHECK_SUCCESS;
 }
@@ -2793,12 +2926,51 @@ SerializedCodeData* SerializedCodeData::FromCachedData(Isolate* isolate,
                                                        String* source) {
   DisallowHeapAllocation no_gc;
   SerializedCodeData* scd = new SerializedCodeData(cached_data);
-  SanityCheckResult r = scd->SanityCheck(isolate, source);
+  SanityCheckResult r;
+  if (cached_data->prechecked()) {
+    // Only the source remains to be checked.
+    r = scd->GetHeaderValue(kSourceHashOffset) == scd->SourceHash(source)
+            ? CHECK_SUCCESS
+            : SOURCE_MISMATCH;
+  } else {
+    r = scd->SanityCheck(isolate, source);
+  }
   if (r == CHECK_SUCCESS) return scd;
   cached_data->Reject();
   source->GetIsolate()->counters()->code_cache_reject_reason()->AddSample(r);
   delete scd;
   return NULL;
 }
+
+
+void SerializedCodeData::Precheck(ScriptData* cached_data,
+                                  uint32_t magic_number, uint32_t flag_hash) {
+  SerializedCodeData scd(cached_data);
+  if (scd.SanityCheckWithoutSource(magic_number, flag_hash) == CHECK_SUCCESS) {
+    cached_data->MarkPrechecked();
+  }
+}
+
+
+ConsumeCodeCacheTask::ConsumeCodeCacheTask(
+    Isolate* isolate, const ScriptCompiler::CachedData* cached_data)
+    : cached_data_(cached_data),
+      magic_number_(SerializedData::ComputeMagicNumber(
+          ExternalReferenceTable::instance(isolate))),
+      flag_hash_(FlagList::Hash()) {}
+
+
+void ConsumeCodeCacheTask::Run() {
+  // ScriptData copies the data if it is not pointer-aligned.
+  script_data_.Reset(new ScriptData(cached_data_->data, cached_data_->length));
+  // If the checks fail, they are repeated on the main thread, which takes
+  // care of rejecting the data and recording the reason.
+  SerializedCodeData::Precheck(script_data_.get(), magic_number_, flag_hash_);
+}
+
+
+ScriptData* ConsumeCodeCacheTask::ReleaseScriptData() {
+  return script_data_.Detach();
+}
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #define V8_SNAPSHOT_SERIALIZE_H_
 
 #include "src/address-map.h"
+#include "src/base/smart-pointers.h"
 #include "src/heap/heap.h"
 #include "src/objects.h"
 #include "src/snapshot/snapshot-source-sink.h"
@@ -374,6 +375,9 @@ class Deserializer: public SerializerDeserializer {
   // Deserialize a shared function info. Fail gracefully.
   MaybeHandle<SharedFunctionInfo> DeserializeCode(Isolate* isolate);
 
+  // Deserialize the code object of a single lazy builtin.
+  MaybeHandle<Code> DeserializeBuiltin(Isolate* isolate);
+
   // Pass a vector of externally-provided objects referenced by the snapshot.
   // The ownership to its backing store is handed over as well.
   void SetAttachedObjects(Vector<Handle<Object> > attached_objects) {
@@ -606,9 +610,13 @@ class Serializer : public SerializerDeserializer {
 };
 
 
+class StartupSerializer;
+
+
 class PartialSerializer : public Serializer {
  public:
-  PartialSerializer(Isolate* isolate, Serializer* startup_snapshot_serializer,
+  PartialSerializer(Isolate* isolate,
+                    StartupSerializer* startup_snapshot_serializer,
                     SnapshotByteSink* sink)
       : Serializer(isolate, sink),
         startup_serializer_(startup_snapshot_serializer),
@@ -624,19 +632,21 @@ class PartialSerializer : public Serializer {
                        WhereToPoint where_to_point, int skip) override;
 
  private:
-  int PartialSnapshotCacheIndex(HeapObject* o);
   bool ShouldBeInThePartialSnapshotCache(HeapObject* o);
 
-  Serializer* startup_serializer_;
+  StartupSerializer* startup_serializer_;
   Object* global_object_;
-  PartialCacheIndexMap partial_cache_index_map_;
   DISALLOW_COPY_AND_ASSIGN(PartialSerializer);
 };
 
 
 class StartupSerializer : public Serializer {
  public:
-  StartupSerializer(Isolate* isolate, SnapshotByteSink* sink);
+  enum BuiltinsHandling { kSerializeBuiltinsEagerly, kSerializeBuiltinsLazily };
+
+  StartupSerializer(Isolate* isolate, SnapshotByteSink* sink,
+                    BuiltinsHandling builtins_handling =
+                        kSerializeBuiltinsEagerly);
   ~StartupSerializer() override { OutputStatistics("StartupSerializer"); }
 
   // The StartupSerializer has to serialize the root array, which is slightly
@@ -652,12 +662,50 @@ class StartupSerializer : public Serializer {
                        WhereToPoint where_to_point, int skip) override;
   void SerializeWeakReferencesAndDeferred();
 
+  // Returns the index of {o} in the partial snapshot cache, adding it to the
+  // cache and to the startup snapshot if it is not there yet.
+  int PartialSnapshotCacheIndex(HeapObject* o);
+
+  // Returns true if the builtin with the given {index} is not part of the
+  // startup snapshot proper, and has to be serialized into a separate
+  // section with a BuiltinSerializer before the weak references.
+  bool IsSerializedLazily(int builtin_index);
+
  private:
   intptr_t root_index_wave_front_;
+  BuiltinsHandling builtins_handling_;
+  PartialCacheIndexMap partial_cache_index_map_;
   DISALLOW_COPY_AND_ASSIGN(StartupSerializer);
 };
 
 
+// Serializes the code of a single lazy builtin, so that it can be
+// deserialized independently on first use. All objects other than the code
+// object itself and its relocation info are referenced through the root
+// array or the partial snapshot cache, which live as long as the isolate.
+class BuiltinSerializer : public Serializer {
+ public:
+  BuiltinSerializer(Isolate* isolate, StartupSerializer* startup_serializer,
+                    SnapshotByteSink* sink)
+      : Serializer(isolate, sink),
+        startup_serializer_(startup_serializer),
+        code_(NULL) {
+    InitializeCodeAddressMap();
+  }
+
+  ~BuiltinSerializer() override { OutputStatistics("BuiltinSerializer"); }
+
+  void Serialize(Builtins::Name name);
+  void SerializeObject(HeapObject* o, HowToCode how_to_code,
+                       WhereToPoint where_to_point, int skip) override;
+
+ private:
+  StartupSerializer* startup_serializer_;
+  Code* code_;
+  DISALLOW_COPY_AND_ASSIGN(BuiltinSerializer);
+};
+
+
 class CodeSerializer : public Serializer {
  public:
   static ScriptData* Serialize(Isolate* isolate,
@@ -751,6 +799,13 @@ class SerializedCodeData : public SerializedData {
                                             ScriptData* cached_data,
                                             String* source);
 
+  // Used when consuming on a background thread. Performs the checks that
+  // do not depend on the source, and marks |cached_data| as prechecked if
+  // they pass. The isolate-dependent expectations are passed in, since they
+  // must be computed on the main thread.
+  static void Precheck(ScriptData* cached_data, uint32_t magic_number,
+                       uint32_t flag_hash);
+
   // Used when producing.
   SerializedCodeData(const List<byte>& payload, const CodeSerializer& cs);
 
@@ -776,6 +831,11 @@ class SerializedCodeData : public SerializedData {
   };
 
   SanityCheckResult SanityCheck(Isolate* isolate, String* source) const;
+  SanityCheckResult SanityCheckWithoutSource(uint32_t magic_number,
+                                             uint32_t flag_hash) const;
+  // Skips the source check if {source} is NULL.
+  SanityCheckResult SanityCheck(uint32_t magic_number, uint32_t flag_hash,
+                                String* source) const;
 
   uint32_t SourceHash(String* source) const;
 
@@ -804,6 +864,31 @@ class SerializedCodeData : public SerializedData {
   static const int kChecksum2Offset = kChecksum1Offset + kInt32Size;
   static const int kHeaderSize = kChecksum2Offset + kInt32Size;
 };
+
+
+// Internal implementation of v8::ScriptCompiler::ConsumeCodeCacheTask. Copies
+// the cached data into an aligned buffer if necessary, and verifies its
+// header and checksum on a background thread.
+class ConsumeCodeCacheTask : public ScriptCompiler::ConsumeCodeCacheTask {
+ public:
+  ConsumeCodeCacheTask(Isolate* isolate,
+                       const ScriptCompiler::CachedData* cached_data);
+
+  void Run() override;
+
+  // Called on the main thread once Run has returned. Transfers ownership of
+  // the (possibly prechecked) data to the caller. Returns NULL if Run was
+  // never called.
+  ScriptData* ReleaseScriptData();
+
+ private:
+  const ScriptCompiler::CachedData* cached_data_;  // Not owned.
+  base::SmartPointer<ScriptData> script_data_;
+  uint32_t magic_number_;
+  uint32_t flag_hash_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConsumeCodeCacheTask);
+};
 }  // namespace internal
 }  // namespace v8
 
@@ -16,7 +16,7 @@ namespace internal {
 #ifdef DEBUG
 bool Snapshot::SnapshotIsValid(v8::StartupData* snapshot_blob) {
   return !Snapshot::ExtractStartupData(snapshot_blob).is_empty() &&
-         !Snapshot::ExtractContextData(snapshot_blob).is_empty();
+         !Snapshot::ExtractContextData(snapshot_blob, 0).is_empty();
 }
 #endif  // DEBUG
 
@@ -28,6 +28,13 @@ bool Snapshot::HaveASnapshotToStartFrom(Isolate* isolate) {
 }
 
 
+bool Snapshot::HasContextSnapshot(Isolate* isolate, size_t context_index) {
+  if (!isolate->snapshot_available()) return false;
+  int num_contexts = ExtractNumContexts(isolate->snapshot_blob());
+  return context_index < static_cast<size_t>(num_contexts);
+}
+
+
 bool Snapshot::EmbedsScript(Isolate* isolate) {
   if (!isolate->snapshot_available()) return false;
   return ExtractMetadata(isolate->snapshot_blob()).embeds_script();
@@ -47,6 +54,22 @@ uint32_t Snapshot::SizeOfFirstPage(Isolate* isolate, AllocationSpace space) {
 
 
 bool Snapshot::Initialize(Isolate* isolate) {
+  // Lazy builtins are only deserialized on demand from the default snapshot,
+  // which outlives the isolate. Blobs passed in by the embedder may go away
+  // as soon as the isolate has been set up, and a snapshot can only be
+  // created from fully deserialized builtins.
+  return Initialize(isolate,
+                    isolate->snapshot_blob() == DefaultSnapshotBlob() &&
+                        !isolate->serializer_enabled());
+}
+
+
+bool Snapshot::InitializeWithLazyBuiltinsForTesting(Isolate* isolate) {
+  return Initialize(isolate, true);
+}
+
+
+bool Snapshot::Initialize(Isolate* isolate, bool keep_lazy_builtins) {
   if (!isolate->snapshot_available()) return false;
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
@@ -56,6 +79,9 @@ bool Snapshot::Initialize(Isolate* isolate) {
   SnapshotData snapshot_data(startup_data);
   Deserializer deserializer(&snapshot_data);
   bool success = isolate->Init(&deserializer);
+  if (success && !keep_lazy_builtins) {
+    isolate->builtins()->DeserializeLazyBuiltins();
+  }
   if (FLAG_profile_deserialization) {
     double ms = timer.Elapsed().InMillisecondsF();
     int bytes = startup_data.length();
@@ -66,13 +92,15 @@ bool Snapshot::Initialize(Isolate* isolate) {
 
 
 MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
-    Isolate* isolate, Handle<JSGlobalProxy> global_proxy) {
-  if (!isolate->snapshot_available()) return Handle<Context>();
+    Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+    size_t context_index) {
+  if (!HasContextSnapshot(isolate, context_index)) return Handle<Context>();
   base::ElapsedTimer timer;
   if (FLAG_profile_deserialization) timer.Start();
 
   const v8::StartupData* blob = isolate->snapshot_blob();
-  Vector<const byte> context_data = ExtractContextData(blob);
+  Vector<const byte> context_data =
+      ExtractContextData(blob, static_cast<int>(context_index));
   SnapshotData snapshot_data(context_data);
   Deserializer deserializer(&snapshot_data);
 
@@ -90,6 +118,28 @@ MaybeHandle<Context> Snapshot::NewContextFromSnapshot(
 }
 
 
+Handle<Code> Snapshot::DeserializeBuiltin(Isolate* isolate,
+                                          int builtin_index) {
+  base::ElapsedTimer timer;
+  if (FLAG_profile_deserialization) timer.Start();
+
+  const v8::StartupData* blob = isolate->snapshot_blob();
+  Vector<const byte> builtin_data = ExtractBuiltinData(blob, builtin_index);
+  SnapshotData snapshot_data(builtin_data);
+  Deserializer deserializer(&snapshot_data);
+
+  Handle<Code> result =
+      deserializer.DeserializeBuiltin(isolate).ToHandleChecked();
+  if (FLAG_profile_deserialization) {
+    double ms = timer.Elapsed().InMillisecondsF();
+    int bytes = builtin_data.length();
+    PrintF("[Deserializing builtin %s (%d bytes) took %0.3f ms]\n",
+           isolate->builtins()->name(builtin_index), bytes, ms);
+  }
+  return result;
+}
+
+
 void CalculateFirstPageSizes(bool is_default_snapshot,
                              const SnapshotData& startup_snapshot,
                              const SnapshotData& context_snapshot,
@@ -161,39 +211,79 @@ void CalculateFirstPageSizes(bool is_default_snapshot,
 
 
 v8::StartupData Snapshot::CreateSnapshotBlob(
-    const i::StartupSerializer& startup_ser,
-    const i::PartialSerializer& context_ser, Snapshot::Metadata metadata) {
-  SnapshotData startup_snapshot(startup_ser);
-  SnapshotData context_snapshot(context_ser);
-  Vector<const byte> startup_data = startup_snapshot.RawData();
-  Vector<const byte> context_data = context_snapshot.RawData();
+    const SnapshotData* startup_snapshot,
+    const List<SnapshotData*>* context_snapshots,
+    const List<SnapshotData*>* builtin_snapshots, Snapshot::Metadata metadata) {
+  int num_contexts = context_snapshots->length();
+  DCHECK_LT(0, num_contexts);
+  DCHECK_EQ(Builtins::builtin_count, builtin_snapshots->length());
+  Vector<const byte> startup_data = startup_snapshot->RawData();
 
   uint32_t first_page_sizes[kNumPagedSpaces];
 
-  CalculateFirstPageSizes(!metadata.embeds_script(), startup_snapshot,
-                          context_snapshot, first_page_sizes);
+  // The first page sizes are tailored to the default context.
+  CalculateFirstPageSizes(!metadata.embeds_script(), *startup_snapshot,
+                          *context_snapshots->at(0), first_page_sizes);
 
   int startup_length = startup_data.length();
-  int context_length = context_data.length();
-  int context_offset = ContextOffset(startup_length);
-
-  int length = context_offset + context_length;
+  int startup_offset = StartupDataOffset(num_contexts);
+  int length = startup_offset + startup_length;
+  for (int i = 0; i < num_contexts; ++i) {
+    length += context_snapshots->at(i)->RawData().length();
+  }
+  int builtins_length = 0;
+  for (SnapshotData* builtin_snapshot : *builtin_snapshots) {
+    if (builtin_snapshot == NULL) continue;
+    builtins_length += builtin_snapshot->RawData().length();
+  }
+  length += builtins_length;
   char* data = new char[length];
 
   memcpy(data + kMetadataOffset, &metadata.RawValue(), kInt32Size);
   memcpy(data + kFirstPageSizesOffset, first_page_sizes,
          kNumPagedSpaces * kInt32Size);
+  memcpy(data + kNumberOfContextsOffset, &num_contexts, kInt32Size);
   memcpy(data + kStartupLengthOffset, &startup_length, kInt32Size);
-  memcpy(data + kStartupDataOffset, startup_data.begin(), startup_length);
-  memcpy(data + context_offset, context_data.begin(), context_length);
+  memcpy(data + startup_offset, startup_data.begin(), startup_length);
+
+  int context_offset = startup_offset + startup_length;
+  for (int i = 0; i < num_contexts; ++i) {
+    Vector<const byte> context_data = context_snapshots->at(i)->RawData();
+    int context_length = context_data.length();
+    memcpy(data + ContextOffsetOffset(i), &context_offset, kInt32Size);
+    memcpy(data + context_offset, context_data.begin(), context_length);
+    context_offset += context_length;
+  }
+
+  int builtin_offset = context_offset;
+  memcpy(data + kBuiltinsOffsetOffset, &builtin_offset, kInt32Size);
+  int num_lazy_builtins = 0;
+  for (int i = 0; i < Builtins::builtin_count; ++i) {
+    int builtin_length = 0;
+    SnapshotData* builtin_snapshot = builtin_snapshots->at(i);
+    if (builtin_snapshot != NULL) {
+      Vector<const byte> builtin_data = builtin_snapshot->RawData();
+      builtin_length = builtin_data.length();
+      memcpy(data + builtin_offset, builtin_data.begin(), builtin_length);
+      num_lazy_builtins++;
+    }
+    int offset_offset = BuiltinOffsetOffset(num_contexts, i);
+    memcpy(data + offset_offset, &builtin_offset, kInt32Size);
+    memcpy(data + offset_offset + kInt32Size, &builtin_length, kInt32Size);
+    builtin_offset += builtin_length;
+  }
+  DCHECK_EQ(length, builtin_offset);
   v8::StartupData result = {data, length};
 
   if (FLAG_profile_deserialization) {
     PrintF(
         "Snapshot blob consists of:\n"
         "%10d bytes for startup\n"
-        "%10d bytes for context\n",
-        startup_length, context_length);
+        "%10d bytes for %d contexts\n"
+        "%10d bytes for %d lazy builtins\n",
+        startup_length,
+        length - startup_offset - startup_length - builtins_length,
+        num_contexts, builtins_length, num_lazy_builtins);
   }
   return result;
 }
@@ -206,27 +296,70 @@ Snapshot::Metadata Snapshot::ExtractMetadata(const v8::StartupData* data) {
 }
 
 
+int Snapshot::ExtractNumContexts(const v8::StartupData* data) {
+  CHECK_LT(kNumberOfContextsOffset, data->raw_size);
+  int num_contexts;
+  memcpy(&num_contexts, data->data + kNumberOfContextsOffset, kInt32Size);
+  return num_contexts;
+}
+
+
 Vector<const byte> Snapshot::ExtractStartupData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
+  int num_contexts = ExtractNumContexts(data);
+  int startup_offset = StartupDataOffset(num_contexts);
+  CHECK_LT(startup_offset, data->raw_size);
   int startup_length;
   memcpy(&startup_length, data->data + kStartupLengthOffset, kInt32Size);
-  DCHECK_LT(startup_length, data->raw_size);
+  CHECK_LT(startup_length, data->raw_size);
   const byte* startup_data =
-      reinterpret_cast<const byte*>(data->data + kStartupDataOffset);
+      reinterpret_cast<const byte*>(data->data + startup_offset);
   return Vector<const byte>(startup_data, startup_length);
 }
 
 
-Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data) {
-  DCHECK_LT(kIntSize, data->raw_size);
-  int startup_length;
-  memcpy(&startup_length, data->data + kStartupLengthOffset, kIntSize);
-  int context_offset = ContextOffset(startup_length);
+Vector<const byte> Snapshot::ExtractContextData(const v8::StartupData* data,
+                                                int index) {
+  int num_contexts = ExtractNumContexts(data);
+  CHECK_LT(index, num_contexts);
+
+  int context_offset;
+  memcpy(&context_offset, data->data + ContextOffsetOffset(index),
+         kInt32Size);
+  int next_context_offset;
+  if (index == num_contexts - 1) {
+    memcpy(&next_context_offset, data->data + kBuiltinsOffsetOffset,
+           kInt32Size);
+    CHECK_LE(next_context_offset, data->raw_size);
+  } else {
+    memcpy(&next_context_offset, data->data + ContextOffsetOffset(index + 1),
+           kInt32Size);
+    CHECK_LT(next_context_offset, data->raw_size);
+  }
+
   const byte* context_data =
       reinterpret_cast<const byte*>(data->data + context_offset);
-  DCHECK_LT(context_offset, data->raw_size);
-  int context_length = data->raw_size - context_offset;
+  int context_length = next_context_offset - context_offset;
   return Vector<const byte>(context_data, context_length);
 }
+
+
+Vector<const byte> Snapshot::ExtractBuiltinData(const v8::StartupData* data,
+                                                int index) {
+  int num_contexts = ExtractNumContexts(data);
+  CHECK_LT(index, Builtins::builtin_count);
+
+  int offset_offset = BuiltinOffsetOffset(num_contexts, index);
+  int builtin_offset;
+  int builtin_length;
+  memcpy(&builtin_offset, data->data + offset_offset, kInt32Size);
+  memcpy(&builtin_length, data->data + offset_offset + kInt32Size,
+         kInt32Size);
+  CHECK_LT(0, builtin_length);
+  CHECK_LE(builtin_offset + builtin_length, data->raw_size);
+
+  const byte* builtin_data =
+      reinterpret_cast<const byte*>(data->data + builtin_offset);
+  return Vector<const byte>(builtin_data, builtin_length);
+}
 }  // namespace internal
 }  // namespace v8
@@ -35,12 +35,23 @@ class Snapshot : public AllStatic {
   // Initialize the Isolate from the internal snapshot. Returns false if no
   // snapshot could be found.
   static bool Initialize(Isolate* isolate);
+  // Like Initialize, but leaves the lazy builtins to be deserialized on first
+  // use even if the snapshot blob is not the default one. The caller must
+  // keep the blob alive for as long as the isolate.
+  static bool InitializeWithLazyBuiltinsForTesting(Isolate* isolate);
   // Create a new context using the internal partial snapshot.
   static MaybeHandle<Context> NewContextFromSnapshot(
-      Isolate* isolate, Handle<JSGlobalProxy> global_proxy);
+      Isolate* isolate, Handle<JSGlobalProxy> global_proxy,
+      size_t context_index = 0);
+  // Deserialize a lazy builtin from the internal snapshot.
+  static Handle<Code> DeserializeBuiltin(Isolate* isolate, int builtin_index);
 
   static bool HaveASnapshotToStartFrom(Isolate* isolate);
 
+  // Returns true if the snapshot of the {isolate} contains a context
+  // snapshot with the given {context_index}.
+  static bool HasContextSnapshot(Isolate* isolate, size_t context_index);
+
   static bool EmbedsScript(Isolate* isolate);
 
   static uint32_t SizeOfFirstPage(Isolate* isolate, AllocationSpace space);
@@ -49,36 +60,64 @@ class Snapshot : public AllStatic {
   // To be implemented by the snapshot source.
   static const v8::StartupData* DefaultSnapshotBlob();
 
+  // The {builtin_snapshots} hold an entry for every builtin, which is NULL
+  // for builtins that are part of the startup snapshot proper.
   static v8::StartupData CreateSnapshotBlob(
-      const StartupSerializer& startup_ser,
-      const PartialSerializer& context_ser, Snapshot::Metadata metadata);
+      const SnapshotData* startup_snapshot,
+      const List<SnapshotData*>* context_snapshots,
+      const List<SnapshotData*>* builtin_snapshots,
+      Snapshot::Metadata metadata);
 
 #ifdef DEBUG
   static bool SnapshotIsValid(v8::StartupData* snapshot_blob);
 #endif  // DEBUG
 
  private:
+  static bool Initialize(Isolate* isolate, bool keep_lazy_builtins);
+
   static Vector<const byte> ExtractStartupData(const v8::StartupData* data);
-  static Vector<const byte> ExtractContextData(const v8::StartupData* data);
+  static Vector<const byte> ExtractContextData(const v8::StartupData* data,
+                                               int index);
+  static int ExtractNumContexts(const v8::StartupData* data);
+  static Vector<const byte> ExtractBuiltinData(const v8::StartupData* data,
+                                               int index);
   static Metadata ExtractMetadata(const v8::StartupData* data);
 
   // Snapshot blob layout:
   // [0] metadata
   // [1 - 6] pre-calculated first page sizes for paged spaces
-  // [7] serialized start up data length
+  // [7] number of contexts N
+  // [8] serialized start up data length
+  // [9] offset of the serialized builtin data
+  // [10 - (10 + N - 1)] offsets of the serialized context data
+  // [(10 + N) - (10 + N + 2 * B - 1)] offset and length of the serialized
+  //     data for each of the B builtins, the length is 0 for builtins that
+  //     are deserialized with the start up data
   // ... serialized start up data
-  // ... serialized context data
+  // ... serialized context data, for each of the N contexts
+  // ... serialized builtin data, for each of the lazy builtins
 
   static const int kNumPagedSpaces = LAST_PAGED_SPACE - FIRST_PAGED_SPACE + 1;
 
   static const int kMetadataOffset = 0;
   static const int kFirstPageSizesOffset = kMetadataOffset + kInt32Size;
-  static const int kStartupLengthOffset =
+  static const int kNumberOfContextsOffset =
       kFirstPageSizesOffset + kNumPagedSpaces * kInt32Size;
-  static const int kStartupDataOffset = kStartupLengthOffset + kInt32Size;
+  static const int kStartupLengthOffset = kNumberOfContextsOffset + kInt32Size;
+  static const int kBuiltinsOffsetOffset = kStartupLengthOffset + kInt32Size;
+  static const int kFirstContextOffsetOffset =
+      kBuiltinsOffsetOffset + kInt32Size;
+
+  static int StartupDataOffset(int num_contexts) {
+    return BuiltinOffsetOffset(num_contexts, Builtins::builtin_count);
+  }
+
+  static int ContextOffsetOffset(int index) {
+    return kFirstContextOffsetOffset + index * kInt32Size;
+  }
 
-  static int ContextOffset(int startup_length) {
-    return kStartupDataOffset + startup_length;
+  static int BuiltinOffsetOffset(int num_contexts, int index) {
+    return ContextOffsetOffset(num_contexts) + index * 2 * kInt32Size;
   }
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Snapshot);
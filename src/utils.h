@@ -819,6 +819,66 @@ inline int CompareChars(const lchar* lhs, const rchar* rhs, size_t chars) {
 }
 
 
+// Classifies 8bit/16bit chars a word at a time, like String::NonAsciiStart.
+// A word holds kLaneCount chars, one per lane. Classifiers set bit 7 of every
+// lane of an ASCII word whose char is in their class, and RunLength uses them
+// to skip runs of chars in that class.
+template <typename Char>
+class CharLanes {
+ public:
+  static const int kLaneCount = sizeof(uintptr_t) / sizeof(Char);
+  static const uintptr_t kOnes = kUintptrAllBitsSet / static_cast<Char>(-1);
+  static const uintptr_t kBit7 = kOnes * 0x80;
+  // Bits that are only set in lanes with non-ASCII chars.
+  static const uintptr_t kNonAsciiMask =
+      kOnes * static_cast<Char>(static_cast<Char>(-1) & ~0x7F);
+
+  // Sets bit 7 of the lanes of {word} whose char is in [lo, hi]. All lanes
+  // must hold ASCII chars.
+  static inline uintptr_t InRange(uintptr_t word, Char lo, Char hi) {
+    DCHECK(lo <= hi && hi < 0x80);
+    return (word + kOnes * (0x80 - lo)) & ~(word + kOnes * (0x7F - hi)) &
+           kBit7;
+  }
+
+  // Returns the number of chars at the start of {chars} that are in the class
+  // of {classifier}, which provides Contains(Char) for single chars and
+  // Lanes(uintptr_t) for ASCII words. Words with non-ASCII chars are
+  // classified one char at a time, except for one-byte chars if the
+  // classifier's kAcceptsNonAscii says that they are all in its class.
+  template <typename Classifier>
+  static int RunLength(const Classifier& classifier, const Char* chars,
+                       int length) {
+    const Char* cursor = chars;
+    const Char* limit = chars + length;
+    // Check unaligned chars.
+    while (cursor < limit &&
+           !IsAligned(reinterpret_cast<intptr_t>(cursor), sizeof(uintptr_t))) {
+      if (!classifier.Contains(*cursor)) {
+        return static_cast<int>(cursor - chars);
+      }
+      ++cursor;
+    }
+    // Check aligned words.
+    while (cursor + kLaneCount <= limit) {
+      uintptr_t word = *reinterpret_cast<const uintptr_t*>(cursor);
+      uintptr_t non_ascii = word & kNonAsciiMask;
+      if (non_ascii != 0) {
+        if (sizeof(Char) != 1 || !Classifier::kAcceptsNonAscii) break;
+        // The non-ASCII lanes are in the class; classify the others.
+        if ((classifier.Lanes(word & ~non_ascii) | non_ascii) != kBit7) break;
+      } else if (classifier.Lanes(word) != kBit7) {
+        break;
+      }
+      cursor += kLaneCount;
+    }
+    // Check the remaining chars.
+    while (cursor < limit && classifier.Contains(*cursor)) ++cursor;
+    return static_cast<int>(cursor - chars);
+  }
+};
+
+
 // Calculate 10^exponent.
 inline int TenToThe(int exponent) {
   DCHECK(exponent <= 9);
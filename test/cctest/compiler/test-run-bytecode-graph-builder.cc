@@ -984,7 +984,6 @@ TEST(BytecodeGraphBuilderDeleteLookupSlot) {
   Zone* zone = scope.main_zone();
   Factory* factory = isolate->factory();
 
-  // TODO(mythria): Add more tests when we have support for LdaLookupSlot.
   const char* function_prologue = "var f;"
                                   "var x = 1;"
                                   "y = 10;"
@@ -1016,6 +1015,47 @@ TEST(BytecodeGraphBuilderDeleteLookupSlot) {
 }
 
 
+TEST(BytecodeGraphBuilderLookupSlot) {
+  HandleAndZoneScope scope;
+  Isolate* isolate = scope.main_isolate();
+  Zone* zone = scope.main_zone();
+  Factory* factory = isolate->factory();
+
+  const char* function_prologue = "var f;"
+                                  "var x = 12;"
+                                  "y = 10;"
+                                  "var obj = {val:3.1414};"
+                                  "var z = 30;"
+                                  "function f1() {"
+                                  "  var z = 20;"
+                                  "  eval(\"function t() {";
+  const char* function_epilogue = "        }; f = t; t();\");"
+                                  "}"
+                                  "f1();";
+
+  ExpectedSnippet<0> snippets[] = {
+      {"return x;", {factory->NewNumber(12)}},
+      {"return obj.val;", {factory->NewNumber(3.1414)}},
+      {"return typeof x;", {factory->NewStringFromStaticChars("number")}},
+      {"return typeof dummy;",
+       {factory->NewStringFromStaticChars("undefined")}},
+      {"x = 23; return x;", {factory->NewNumber(23)}},
+      {"'use strict'; x = 23; return x;", {factory->NewNumber(23)}}};
+
+  size_t num_snippets = sizeof(snippets) / sizeof(snippets[0]);
+  for (size_t i = 0; i < num_snippets; i++) {
+    ScopedVector<char> script(1024);
+    SNPrintF(script, "%s %s %s", function_prologue, snippets[i].code_snippet,
+             function_epilogue);
+
+    BytecodeGraphTester tester(isolate, zone, script.start(), "t");
+    auto callable = tester.GetCallable<>();
+    Handle<Object> return_value = callable().ToHandleChecked();
+    CHECK(return_value->SameValue(*snippets[i].return_value()));
+  }
+}
+
+
 bool get_compare_result(Token::Value opcode, Handle<Object> lhs_value,
                         Handle<Object> rhs_value) {
   switch (opcode) {
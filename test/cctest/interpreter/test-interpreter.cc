@@ -1230,6 +1230,102 @@ TEST(InterpreterConditionalJumps2) {
 }
 
 
+TEST(InterpreterDispatchCounters) {
+  // The counters table is allocated when the isolate is created, so use a
+  // fresh isolate.
+  FLAG_trace_ignition_dispatches = true;
+  bool old_allow_natives_syntax = FLAG_allow_natives_syntax;
+  FLAG_allow_natives_syntax = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* v8_isolate = v8::Isolate::New(create_params);
+  // The isolate keeps counting after the flag is cleared.
+  FLAG_trace_ignition_dispatches = false;
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    v8::HandleScope handle_scope(v8_isolate);
+    v8::Local<v8::Context> context = v8::Context::New(v8_isolate);
+    v8::Context::Scope context_scope(context);
+    Isolate* isolate = reinterpret_cast<Isolate*>(v8_isolate);
+    Zone zone;
+    BytecodeArrayBuilder builder(isolate, &zone);
+    builder.set_locals_count(1);
+    builder.set_context_count(0);
+    builder.set_parameter_count(0);
+    Register reg(0);
+    builder.LoadLiteral(Smi::FromInt(1))
+        .StoreAccumulatorInRegister(reg)
+        .LoadLiteral(Smi::FromInt(2))
+        .BinaryOperation(Token::Value::ADD, reg, Strength::WEAK)
+        .Return();
+
+    Handle<BytecodeArray> bytecode_array = builder.ToBytecodeArray();
+    InterpreterTester tester(isolate, bytecode_array);
+    auto callable = tester.GetCallable<>();
+    Handle<Object> return_value = callable().ToHandleChecked();
+    CHECK_EQ(Smi::cast(*return_value)->value(), 3);
+
+    // The entry trampoline dispatches to the first bytecode without counting
+    // it, and Return does not dispatch.
+    Interpreter* interpreter = isolate->interpreter();
+    CHECK_EQ(1u, interpreter->GetDispatchCounter(Bytecode::kLdaSmi8,
+                                                 Bytecode::kStar));
+    CHECK_EQ(1u, interpreter->GetDispatchCounter(Bytecode::kStar,
+                                                 Bytecode::kLdaSmi8));
+    CHECK_EQ(1u, interpreter->GetDispatchCounter(Bytecode::kLdaSmi8,
+                                                 Bytecode::kAdd));
+    CHECK_EQ(1u, interpreter->GetDispatchCounter(Bytecode::kAdd,
+                                                 Bytecode::kReturn));
+    CHECK_EQ(0u, interpreter->GetDispatchCounter(Bytecode::kStar,
+                                                 Bytecode::kAdd));
+
+    // The runtime function reports the same counters. The script itself is
+    // not interpreted, so it does not add to them.
+    CHECK_EQ(1, CompileRun("%InterpreterGetDispatchCounters().LdaSmi8.Star")
+                    ->Int32Value(context)
+                    .FromJust());
+    CHECK_EQ(1, CompileRun("%InterpreterGetDispatchCounters().Add.Return")
+                    ->Int32Value(context)
+                    .FromJust());
+    CHECK(CompileRun("%InterpreterGetDispatchCounters().Return")
+              ->IsUndefined());
+  }
+  v8_isolate->Dispose();
+  FLAG_allow_natives_syntax = old_allow_natives_syntax;
+}
+
+
+static void TerminateCurrentExecution(
+    const v8::FunctionCallbackInfo<v8::Value>& info) {
+  info.GetIsolate()->TerminateExecution();
+}
+
+
+TEST(InterpreterTerminateInfiniteLoop) {
+  // The termination request is only noticed by the stack check on the
+  // backward jump of the loop.
+  HandleAndZoneScope handles;
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::Local<v8::Function> terminate =
+      v8::FunctionTemplate::New(isolate, TerminateCurrentExecution)
+          ->GetFunction(context)
+          .ToLocalChecked();
+  CHECK(CcTest::global()->Set(context, v8_str("terminate"), terminate)
+            .FromJust());
+
+  std::string source(
+      InterpreterTester::SourceForBody("terminate();\nwhile (true) {}"));
+  InterpreterTester tester(handles.main_isolate(), source.c_str());
+  auto callable = tester.GetCallable<>();
+
+  v8::TryCatch try_catch(isolate);
+  CHECK(callable().is_null());
+  CHECK(try_catch.HasTerminated());
+  isolate->CancelTerminateExecution();
+}
+
+
 static const Token::Value kComparisonTypes[] = {
     Token::Value::EQ,        Token::Value::NE, Token::Value::EQ_STRICT,
     Token::Value::NE_STRICT, Token::Value::LT, Token::Value::LTE,
@@ -300,6 +300,142 @@ TEST(PreparseFunctionDataIsUsed) {
 }
 
 
+TEST(ParallelPreparse) {
+  // This tests that lazy functions preparsed on background threads are
+  // skipped correctly, and that errors in them are still reported.
+  bool parallel_preparse_flag = i::FLAG_parallel_preparse;
+  int min_length_flag = i::FLAG_min_parallel_preparse_length;
+  i::FLAG_parallel_preparse = true;
+  i::FLAG_min_parallel_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  // Each function returns a + b, or yields it.
+  const char* kFunctions[] = {
+      "function f%d(a, b) { var o = {x: a, y: [b]}; return o.x + o.y[0]; }\n",
+      "function* f%d(a, b) { yield a + b; }\n",
+      "function f%d(a, b = 0) { return a + b; }\n",
+      "var f%d = function(a, b) { 'use strict'; return eval('a + b'); };\n",
+      "(function() { this.f%d = function(a, b) { return a + b; }; })();\n"};
+  const char* kError = "function f%d(a, b) { if ( }\n";
+  const char* kCheck =
+      "var sum = 0;\n"
+      "for (var i = 0; i < %d; i++) {\n"
+      "  var result = this['f' + i](i, 1);\n"
+      "  sum += typeof result == 'object' ? result.next().value : result;\n"
+      "}\n"
+      "sum;\n";
+  const int kCount = 400;
+  const int kLineSize = 100;
+
+  for (int error_line = -1; error_line < kCount; error_line += kCount / 2) {
+    i::ScopedVector<char> program((kCount + 6) * kLineSize);
+    int length = 0;
+    for (int j = 0; j < kCount; j++) {
+      const char* line =
+          j == error_line ? kError : kFunctions[j % arraysize(kFunctions)];
+      length += i::SNPrintF(program.SubVector(length, program.length()), line,
+                            j);
+    }
+    i::SNPrintF(program.SubVector(length, program.length()), kCheck, kCount);
+
+    v8::TryCatch try_catch(isolate);
+    v8::MaybeLocal<v8::Script> script =
+        v8::Script::Compile(context, v8_str(program.start()));
+    if (error_line < 0) {
+      CHECK(!try_catch.HasCaught());
+      v8::Local<v8::Value> result =
+          script.ToLocalChecked()->Run(context).ToLocalChecked();
+      CHECK_EQ(kCount * (kCount + 1) / 2,
+               result->Int32Value(context).FromJust());
+    } else {
+      CHECK(script.IsEmpty());
+      CHECK(try_catch.HasCaught());
+      CHECK_EQ(error_line + 1,
+               try_catch.Message()->GetLineNumber(context).FromJust());
+    }
+  }
+
+  i::FLAG_parallel_preparse = parallel_preparse_flag;
+  i::FLAG_min_parallel_preparse_length = min_length_flag;
+}
+
+
+static int retained_preparse_skipped = 0;
+
+
+static int* LookupRetainedPreparseCounter(const char* name) {
+  if (strcmp(name, "c:V8.RetainedPreparseSkipped") == 0) {
+    return &retained_preparse_skipped;
+  }
+  return NULL;
+}
+
+
+TEST(RetainPreparseData) {
+  // This tests that the script keeps the preparse data of the functions that
+  // were skipped, and that lazy compilation can use it.
+  bool retain_preparse_data_flag = i::FLAG_retain_preparse_data;
+  int min_preparse_length_flag = i::FLAG_min_preparse_length;
+  i::FLAG_retain_preparse_data = true;
+  i::FLAG_min_preparse_length = 0;
+
+  v8::Isolate* isolate = CcTest::isolate();
+  isolate->SetCounterFunction(LookupRetainedPreparseCounter);
+  retained_preparse_skipped = 0;
+  v8::HandleScope handles(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  v8::Context::Scope context_scope(context);
+
+  const char* source =
+      "function outer(x) {\n"
+      "  function inner1(a = [1, 2]) { return a.length + x; }\n"
+      "  var o = { m() { return {p: 1, q: 2}; } };\n"
+      "  function inner2() { return (function() { return 3; })(); }\n"
+      "  var g = (y) => { return y; };\n"
+      "  return inner1() + o.m().q + inner2() + g(0);\n"
+      "}\n"
+      "outer(1);";
+  // The functions in source order, except for the arrow function.
+  const char* kBodies[] = {"{\n  function inner1", "{ return a.length",
+                           "{ return {p: 1", "{ return (function",
+                           "{ return 3"};
+  const int kLiterals[] = {1, 0, 1, 0, 0};
+
+  // Compiling outer skips inner1, m and inner2 with the data. The function
+  // in inner2 is parenthesized, so compiling inner2 parses it eagerly. The
+  // result depends on x, which only the skipped inner1 refers to.
+  CHECK_EQ(8, CompileRun(source)->Int32Value(context).FromJust());
+  CHECK_EQ(3, retained_preparse_skipped);
+
+  i::Handle<i::JSFunction> outer = i::Handle<i::JSFunction>::cast(
+      v8::Utils::OpenHandle(*CompileRun("outer")));
+  i::Script* script = i::Script::cast(outer->shared()->script());
+  CHECK(script->preparse_data()->IsByteArray());
+  i::ByteArray* data = i::ByteArray::cast(script->preparse_data());
+  CHECK_EQ(static_cast<int>(arraysize(kBodies) * i::FunctionEntry::kSize *
+                            sizeof(unsigned)),
+           data->length());
+  const unsigned* entries =
+      reinterpret_cast<const unsigned*>(data->GetDataStartAddress());
+  for (size_t j = 0; j < arraysize(kBodies); j++) {
+    i::FunctionEntry entry(i::Vector<unsigned>(
+        const_cast<unsigned*>(entries) + j * i::FunctionEntry::kSize,
+        i::FunctionEntry::kSize));
+    CHECK_EQ(static_cast<int>(strstr(source, kBodies[j]) - source),
+             entry.start_pos());
+    CHECK_EQ(kLiterals[j], entry.literal_count());
+  }
+
+  isolate->SetCounterFunction(NULL);
+  i::FLAG_retain_preparse_data = retain_preparse_data_flag;
+  i::FLAG_min_preparse_length = min_preparse_length_flag;
+}
+
+
 TEST(StandAlonePreParser) {
   v8::V8::Initialize();
 
@@ -576,6 +712,8 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
       i::Handle<i::ExternalTwoByteString>::cast(uc16_string), start, end);
   i::GenericStringUtf16CharacterStream string_stream(one_byte_string, start,
                                                      end);
+  i::GenericStringUtf16CharacterStream one_byte_stream(
+      reinterpret_cast<const uint8_t*>(one_byte_source), start, end);
   i::Utf8ToUtf16CharacterStream utf8_stream(
       reinterpret_cast<const i::byte*>(one_byte_source), end);
   utf8_stream.SeekForward(start);
@@ -585,17 +723,21 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
-    int32_t c3 = utf8_stream.Advance();
+    int32_t c3 = one_byte_stream.Advance();
+    int32_t c4 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
   while (i > start + sub_length / 4) {
@@ -603,65 +745,81 @@ void TestCharacterStream(const char* one_byte_source, unsigned length,
     int32_t c0 = one_byte_source[i - 1];
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
+    one_byte_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
-    int32_t c3 = utf8_stream.Advance();
+    int32_t c3 = one_byte_stream.Advance();
+    int32_t c4 = utf8_stream.Advance();
     i++;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     uc16_stream.PushBack(c0);
     string_stream.PushBack(c0);
+    one_byte_stream.PushBack(c0);
     utf8_stream.PushBack(c0);
     i--;
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
   unsigned halfway = start + sub_length / 2;
   uc16_stream.SeekForward(halfway - i);
   string_stream.SeekForward(halfway - i);
+  one_byte_stream.SeekForward(halfway - i);
   utf8_stream.SeekForward(halfway - i);
   i = halfway;
   CHECK_EQU(i, uc16_stream.pos());
   CHECK_EQU(i, string_stream.pos());
+  CHECK_EQU(i, one_byte_stream.pos());
   CHECK_EQU(i, utf8_stream.pos());
 
   while (i < end) {
     // Read streams one char at a time
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
     int32_t c0 = one_byte_source[i];
     int32_t c1 = uc16_stream.Advance();
     int32_t c2 = string_stream.Advance();
-    int32_t c3 = utf8_stream.Advance();
+    int32_t c3 = one_byte_stream.Advance();
+    int32_t c4 = utf8_stream.Advance();
     i++;
     CHECK_EQ(c0, c1);
     CHECK_EQ(c0, c2);
     CHECK_EQ(c0, c3);
+    CHECK_EQ(c0, c4);
     CHECK_EQU(i, uc16_stream.pos());
     CHECK_EQU(i, string_stream.pos());
+    CHECK_EQU(i, one_byte_stream.pos());
     CHECK_EQU(i, utf8_stream.pos());
   }
 
   int32_t c1 = uc16_stream.Advance();
   int32_t c2 = string_stream.Advance();
-  int32_t c3 = utf8_stream.Advance();
+  int32_t c3 = one_byte_stream.Advance();
+  int32_t c4 = utf8_stream.Advance();
   CHECK_LT(c1, 0);
   CHECK_LT(c2, 0);
   CHECK_LT(c3, 0);
+  CHECK_LT(c4, 0);
 }
 
 
@@ -825,6 +983,48 @@ TEST(StreamScanner) {
 }
 
 
+TEST(ScanLongRuns) {
+  // Identifiers, blanks, strings and comments are scanned in runs. Test runs
+  // that are longer than the buffer of the stream.
+  v8::V8::Initialize();
+  const int kRunLength = 600;
+  std::string source = "a";
+  for (int i = 0; i < kRunLength; i++) source += "Bc9_$"[i % 5];
+  for (int i = 0; i < kRunLength; i++) source += " \t"[i % 2];
+  source += "\"" + std::string(kRunLength / 2, 'x') + "\\n" +
+            std::string(kRunLength / 2, 'y') + "\"";
+  source += "// " + std::string(kRunLength, '*') + "\nw";
+  source += "/*" + std::string(kRunLength, 'a') + "*b*/Z";
+
+  i::Utf8ToUtf16CharacterStream stream(
+      reinterpret_cast<const i::byte*>(source.c_str()),
+      static_cast<unsigned>(source.length()));
+  i::Scanner scanner(CcTest::i_isolate()->unicode_cache());
+  scanner.Initialize(&stream);
+  i::Zone zone;
+  i::AstValueFactory ast_value_factory(
+      &zone, CcTest::i_isolate()->heap()->HashSeed());
+
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(kRunLength + 1, scanner.CurrentSymbol(&ast_value_factory)->length());
+  CHECK(!scanner.HasAnyLineTerminatorBeforeNext());
+
+  CHECK_EQ(i::Token::STRING, scanner.Next());
+  const i::AstRawString* string = scanner.CurrentSymbol(&ast_value_factory);
+  CHECK_EQ(kRunLength + 1, string->length());
+  CHECK_EQ('\n', string->raw_data()[kRunLength / 2]);
+  CHECK_EQ('y', string->raw_data()[kRunLength]);
+  CHECK(scanner.HasAnyLineTerminatorBeforeNext());
+
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK(!scanner.HasAnyLineTerminatorBeforeNext());
+  CHECK_EQ(i::Token::IDENTIFIER, scanner.Next());
+  CHECK_EQ(static_cast<int>(source.length()) - 1,
+           scanner.location().beg_pos);
+  CHECK_EQ(i::Token::EOS, scanner.Next());
+}
+
+
 void TestScanRegExp(const char* re_source, const char* expected) {
   i::Utf8ToUtf16CharacterStream stream(
        reinterpret_cast<const i::byte*>(re_source),
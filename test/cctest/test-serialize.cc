@@ -1517,6 +1517,76 @@ TEST(SerializeToplevelIsolates) {
 }
 
 
+TEST(CodeCacheAfterExecute) {
+  FLAG_serialize_toplevel = true;
+
+  const char* source =
+      "function f() { return g(); }"
+      "function g() { return 'abc'; }"
+      "function h() { return 'unused'; }"
+      "f() + 'def'";
+  v8::ScriptCompiler::CachedData* cache;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate1, &source, v8::ScriptCompiler::kNoCompileOptions)
+            .ToLocalChecked();
+    CHECK(!source.GetCachedData());
+
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+
+    // The cache also covers f and g, which were compiled lazily by the run.
+    cache = v8::ScriptCompiler::CreateCodeCache(script, source_str);
+    CHECK(cache);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache);
+    {
+      DisallowCompilation no_compile(reinterpret_cast<Isolate*>(isolate2));
+      v8::Local<v8::UnboundScript> script =
+          v8::ScriptCompiler::CompileUnboundScript(
+              isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+              .ToLocalChecked();
+      CHECK(!cache->rejected);
+      v8::Local<v8::Value> result =
+          script->BindToCurrentContext()->Run(context).ToLocalChecked();
+      CHECK(result->ToString(context)
+                .ToLocalChecked()
+                ->Equals(context, v8_str("abcdef"))
+                .FromJust());
+    }
+  }
+  isolate2->Dispose();
+}
+
+
 TEST(SerializeToplevelFlagChange) {
   FLAG_serialize_toplevel = true;
 
@@ -1577,6 +1647,86 @@ TEST(SerializeToplevelBitFlip) {
 }
 
 
+class ConsumeCodeCacheThread : public v8::base::Thread {
+ public:
+  explicit ConsumeCodeCacheThread(
+      v8::ScriptCompiler::ConsumeCodeCacheTask* task)
+      : Thread(Options("ConsumeCodeCacheThread")), task_(task) {}
+
+  void Run() override { task_->Run(); }
+
+ private:
+  v8::ScriptCompiler::ConsumeCodeCacheTask* task_;
+};
+
+
+static bool ConsumeCacheOnBackgroundThread(const char* source,
+                                           bool corrupt_cache,
+                                           bool run_task = true) {
+  v8::ScriptCompiler::CachedData* cache = ProduceCache(source);
+  // Random bit flip.
+  if (corrupt_cache) const_cast<uint8_t*>(cache->data)[337] ^= 0x40;
+
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  bool rejected;
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptCompiler::ConsumeCodeCacheTask* task =
+        v8::ScriptCompiler::StartConsumingCodeCache(isolate2, cache);
+    if (run_task) {
+      ConsumeCodeCacheThread thread(task);
+      thread.Start();
+      thread.Join();
+    }
+
+    v8::Local<v8::String> source_str = v8_str(source);
+    v8::ScriptOrigin origin(v8_str("test"));
+    v8::ScriptCompiler::Source source(source_str, origin, cache, task);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    rejected = cache->rejected;
+    v8::Local<v8::Value> result =
+        script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK(result->ToString(context)
+              .ToLocalChecked()
+              ->Equals(context, v8_str("abcdef"))
+              .FromJust());
+  }
+  isolate2->Dispose();
+  return rejected;
+}
+
+
+TEST(SerializeToplevelConsumeOnBackgroundThread) {
+  FLAG_serialize_toplevel = true;
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  CHECK(!ConsumeCacheOnBackgroundThread(source, false));
+}
+
+
+TEST(SerializeToplevelConsumeOnBackgroundThreadBitFlip) {
+  FLAG_serialize_toplevel = true;
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  CHECK(ConsumeCacheOnBackgroundThread(source, true));
+}
+
+
+TEST(SerializeToplevelConsumeTaskNotRun) {
+  FLAG_serialize_toplevel = true;
+  const char* source = "function f() { return 'abc'; }; f() + 'def'";
+  // The cache is consumed on the main thread instead.
+  CHECK(!ConsumeCacheOnBackgroundThread(source, false, false));
+}
+
+
 TEST(SerializeWithHarmonyScoping) {
   FLAG_serialize_toplevel = true;
 
@@ -1772,3 +1922,147 @@ TEST(SerializationMemoryStats) {
   v8::StartupData blob = v8::V8::CreateSnapshotDataBlob();
   delete[] blob.data;
 }
+
+
+TEST(SnapshotCreatorMultipleContexts) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator;
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 1; }");
+      CHECK_EQ(0u, creator.AddContext(context));
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(context);
+      CompileRun("var f = function() { return 2; }");
+      CHECK_EQ(1u, creator.AddContext(context));
+    }
+    blob = creator.CreateBlob();
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 0).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 1);
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 1).ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f()", 2);
+    }
+    {
+      v8::HandleScope handle_scope(isolate);
+      CHECK(v8::Context::FromSnapshot(isolate, 2).IsEmpty());
+    }
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
+
+intptr_t snapshot_creator_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializationFunctionTemplate), 0};
+
+
+TEST(SnapshotCreatorTemplates) {
+  DisableTurbofan();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator(snapshot_creator_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::FunctionTemplate> callback =
+          v8::FunctionTemplate::New(isolate, SerializationFunctionTemplate);
+      v8::Local<v8::ObjectTemplate> global_template =
+          v8::ObjectTemplate::New(isolate);
+      global_template->Set(v8_str("f"), callback);
+      v8::Local<v8::Context> context =
+          v8::Context::New(isolate, NULL, global_template);
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("f(42)", 42);
+      CHECK_EQ(0u, creator.AddContext(context));
+      CHECK_EQ(0u, creator.AddTemplate(callback));
+      CHECK_EQ(1u, creator.AddTemplate(global_template));
+    }
+    blob = creator.CreateBlob();
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  params.external_references = snapshot_creator_external_references;
+  v8::Isolate* isolate = v8::Isolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context =
+        v8::Context::FromSnapshot(isolate, 0).ToLocalChecked();
+    v8::Context::Scope context_scope(context);
+    ExpectInt32("f(43)", 43);
+
+    v8::Local<v8::FunctionTemplate> callback =
+        v8::FunctionTemplate::FromSnapshot(isolate, 0).ToLocalChecked();
+    v8::Local<v8::ObjectTemplate> global_template =
+        v8::ObjectTemplate::FromSnapshot(isolate, 1).ToLocalChecked();
+    CHECK(v8::ObjectTemplate::FromSnapshot(isolate, 0).IsEmpty());
+    CHECK(v8::FunctionTemplate::FromSnapshot(isolate, 2).IsEmpty());
+
+    v8::Local<v8::Context> new_context =
+        v8::Context::New(isolate, NULL, global_template);
+    v8::Context::Scope new_context_scope(new_context);
+    ExpectInt32("f(44)", 44);
+    CHECK(callback->GetFunction(new_context).ToLocalChecked()->IsFunction());
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
+
+UNINITIALIZED_TEST(LazyBuiltinsDeserializedOnFirstUse) {
+  DisableTurbofan();
+  FLAG_lazy_deserialization = true;
+  v8::StartupData blob = v8::V8::CreateSnapshotDataBlob();
+  FLAG_lazy_deserialization = false;
+
+  Isolate* isolate = new TestIsolate(false);
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate);
+  isolate->set_snapshot_blob(&blob);
+  {
+    v8::Isolate::Scope isolate_scope(v8_isolate);
+    CHECK(Snapshot::InitializeWithLazyBuiltinsForTesting(isolate));
+    HandleScope scope(isolate);
+    Builtins* builtins = isolate->builtins();
+    int num_lazy_builtins = 0;
+    for (int i = 0; i < Builtins::builtin_count; i++) {
+      Builtins::Name name = static_cast<Builtins::Name>(i);
+      if (builtins->is_deserialized(name)) continue;
+      CHECK(Builtins::IsLazy(i));
+      num_lazy_builtins++;
+      Handle<Code> code = builtins->builtin_handle(name);
+      CHECK(builtins->is_deserialized(name));
+      CHECK_EQ(*code, builtins->builtin(name));
+      CHECK_EQ(i, code->builtin_index());
+    }
+    CHECK_LT(0, num_lazy_builtins);
+  }
+  v8_isolate->Dispose();
+  delete[] blob.data;
+}
@@ -0,0 +1,90 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('IteratorResult', [1000], [
+  new Benchmark('IteratorResult', false, false, 0,
+                IteratorResult, Setup, IteratorResultTearDown),
+]);
+
+new BenchmarkSuite('Tuple', [1000], [
+  new Benchmark('Tuple', false, false, 0, Tuple, Setup, TupleTearDown),
+]);
+
+new BenchmarkSuite('Accumulator', [1000], [
+  new Benchmark('Accumulator', false, false, 0,
+                Accumulator, Setup, AccumulatorTearDown),
+]);
+
+var N = 1000;
+var result;
+
+function Setup() {
+  result = undefined;
+}
+
+// ----------------------------------------------------------------------------
+
+function RangeIterator(n) {
+  this.i = 0;
+  this.n = n;
+}
+
+RangeIterator.prototype.next = function() {
+  var i = this.i;
+  if (i < this.n) {
+    this.i = i + 1;
+    return {value: i, done: false};
+  }
+  return {value: undefined, done: true};
+};
+
+function IteratorResult() {
+  var it = new RangeIterator(N);
+  var sum = 0;
+  while (true) {
+    var r = it.next();
+    if (r.done) break;
+    sum += r.value;
+  }
+  result = sum;
+}
+
+function IteratorResultTearDown() {
+  return result === N * (N - 1) / 2;
+}
+
+// ----------------------------------------------------------------------------
+
+function Pair(first, second) {
+  this.first = first;
+  this.second = second;
+}
+
+function Tuple() {
+  var sum = 0;
+  for (var i = 0; i < N; i++) {
+    var p = new Pair(i, i + 1);
+    sum += p.first * p.second;
+  }
+  result = sum;
+}
+
+function TupleTearDown() {
+  return result === (N - 1) * N * (N + 1) / 3;
+}
+
+// ----------------------------------------------------------------------------
+
+function Accumulator() {
+  var acc = new Pair(0, 0);
+  for (var i = 0; i < N; i++) {
+    acc.first += i;
+    acc.second += 2 * i;
+  }
+  result = acc.first + acc.second;
+}
+
+function AccumulatorTearDown() {
+  return result === 3 * N * (N - 1) / 2;
+}
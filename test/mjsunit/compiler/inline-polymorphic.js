@@ -0,0 +1,62 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-inlining --turbo-polymorphic-inlining
+
+// Test inlining at call sites with a phi of known call targets.
+(function() {
+  function f(x) { return x + 1; }
+  function g(x) { return x * 2; }
+  function foo(c, x) { return (c ? f : g)(x); }
+
+  assertEquals(2, foo(true, 1));
+  assertEquals(2, foo(false, 1));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(3, foo(true, 2));
+  assertEquals(4, foo(false, 2));
+})();
+
+// Test inlining of polymorphic method calls.
+(function() {
+  function A() {}
+  A.prototype.m = function() { return "A"; };
+  function B() {}
+  B.prototype.m = function() { return "B"; };
+  function foo(o) { return o.m(); }
+
+  var a = new A();
+  var b = new B();
+  assertEquals("A", foo(a));
+  assertEquals("B", foo(b));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals("A", foo(a));
+  assertEquals("B", foo(b));
+})();
+
+// Test inlining of polymorphic calls via Function.prototype.call.
+(function() {
+  function f() { return this.x; }
+  function g() { return -this.x; }
+  function foo(c, o) { return (c ? f : g).call(o); }
+
+  var o = {x: 1};
+  assertEquals(1, foo(true, o));
+  assertEquals(-1, foo(false, o));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(1, foo(true, o));
+  assertEquals(-1, foo(false, o));
+})();
+
+// Test that exceptions thrown from the inlined targets are propagated.
+(function() {
+  function f() { throw "f"; }
+  function g() { return "g"; }
+  function foo(c) { return (c ? f : g)(); }
+
+  assertThrows(function() { foo(true); });
+  assertEquals("g", foo(false));
+  %OptimizeFunctionOnNextCall(foo);
+  assertThrows(function() { foo(true); });
+  assertEquals("g", foo(false));
+})();
@@ -0,0 +1,51 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Test that JSON.parse handles runs of whitespace, string characters and
+// digits that start and end at every offset of a word.
+
+function repeat(s, n) {
+  var result = "";
+  for (var i = 0; i < n; i++) result += s;
+  return result;
+}
+
+for (var pad = 0; pad < 20; pad++) {
+  var prefix = repeat(" ", pad);
+
+  // Whitespace.
+  var ws = repeat(" \t\n\r", pad);
+  assertEquals([1, 2], JSON.parse(prefix + "[" + ws + "1" + ws + "," + ws +
+                                  "2" + ws + "]" + ws));
+  assertThrows(function() { JSON.parse(ws + "\u000b1"); }, SyntaxError);
+
+  // Strings, as values and as keys.
+  var str = repeat("abc", pad);
+  assertEquals(str, JSON.parse(prefix + '"' + str + '"'));
+  assertEquals(str + '"' + str,
+               JSON.parse(prefix + '"' + str + '\\"' + str + '"'));
+  assertEquals(str + "\u00e9\u00ff",
+               JSON.parse(prefix + '"' + str + "\u00e9\u00ff" + '"'));
+  var object = JSON.parse(prefix + '{"' + str + 'x":' + pad + ',"' + str +
+                          '\\ty": "' + str + '"}');
+  assertEquals(pad, object[str + "x"]);
+  assertEquals(str, object[str + "\ty"]);
+  assertThrows(function() { JSON.parse(prefix + '"' + str + '\n"'); },
+               SyntaxError);
+  assertThrows(function() { JSON.parse(prefix + '{"' + str + '\u001f": 1}'); },
+               SyntaxError);
+  assertThrows(function() { JSON.parse(prefix + '"' + str); }, SyntaxError);
+  assertThrows(function() { JSON.parse(prefix + '{"' + str); }, SyntaxError);
+
+  // Numbers.
+  var digits = repeat("1234567890", pad + 1).substring(0, pad + 1);
+  assertEquals(Number(digits), JSON.parse(prefix + digits));
+  assertEquals(-Number(digits), JSON.parse(prefix + "-" + digits));
+  assertEquals(Number(digits + "." + digits + "e" + (pad % 10)),
+               JSON.parse(prefix + digits + "." + digits + "e" + (pad % 10)));
+  assertThrows(function() { JSON.parse(prefix + digits + "."); },
+               SyntaxError);
+  assertThrows(function() { JSON.parse(prefix + digits + "e+"); },
+               SyntaxError);
+}
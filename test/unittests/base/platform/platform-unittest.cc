@@ -4,6 +4,8 @@
 
 #include "src/base/platform/platform.h"
 
+#include <cstring>
+
 #if V8_OS_POSIX
 #include <unistd.h>  // NOLINT
 #endif
@@ -34,6 +36,25 @@ TEST(OS, GetCurrentProcessId) {
 }
 
 
+TEST(OS, MemoryMappedFileReadOnly) {
+  static const char kFileName[] = "v8-platform-unittest-mapped-file.bin";
+  char contents[] = "startup data blob";
+  OS::MemoryMappedFile* file =
+      OS::MemoryMappedFile::create(kFileName, sizeof(contents), contents);
+  ASSERT_TRUE(file != NULL);
+  delete file;
+
+  file = OS::MemoryMappedFile::open(
+      kFileName, OS::MemoryMappedFile::FileMode::kReadOnly);
+  ASSERT_TRUE(file != NULL);
+  EXPECT_EQ(sizeof(contents), file->size());
+  EXPECT_EQ(0, memcmp(contents, file->memory(), sizeof(contents)));
+  delete file;
+
+  EXPECT_TRUE(OS::Remove(kFileName));
+}
+
+
 namespace {
 
 class ThreadLocalStorageTest : public Thread, public ::testing::Test {
@@ -79,6 +79,52 @@ TEST_F(BranchEliminationTest, NestedBranchSameTrue) {
 }
 
 
+TEST_F(BranchEliminationTest, NestedMapCheckDifferentMap) {
+  // { return (x == map1 ? (x == map2 ? 1 : 2) : 3; }
+  // should be reduced to
+  // { return (x == map1 ? 2 : 3; }
+  Node* map = Parameter(0);
+  Node* condition1 =
+      graph()->NewNode(machine()->WordEqual(), map,
+                       HeapConstant(factory()->fixed_array_map()));
+  Node* condition2 =
+      graph()->NewNode(machine()->WordEqual(), map,
+                       HeapConstant(factory()->heap_number_map()));
+  Node* outer_branch =
+      graph()->NewNode(common()->Branch(), condition1, graph()->start());
+
+  Node* outer_if_true = graph()->NewNode(common()->IfTrue(), outer_branch);
+  Node* inner_branch =
+      graph()->NewNode(common()->Branch(), condition2, outer_if_true);
+  Node* inner_if_true = graph()->NewNode(common()->IfTrue(), inner_branch);
+  Node* inner_if_false = graph()->NewNode(common()->IfFalse(), inner_branch);
+  Node* inner_merge =
+      graph()->NewNode(common()->Merge(2), inner_if_true, inner_if_false);
+  Node* inner_phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                       Int32Constant(1), Int32Constant(2), inner_merge);
+
+  Node* outer_if_false = graph()->NewNode(common()->IfFalse(), outer_branch);
+  Node* outer_merge =
+      graph()->NewNode(common()->Merge(2), inner_merge, outer_if_false);
+  Node* outer_phi =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                       inner_phi, Int32Constant(3), outer_merge);
+
+  Node* ret = graph()->NewNode(common()->Return(), outer_phi, graph()->start(),
+                               outer_merge);
+  graph()->SetEnd(graph()->NewNode(common()->End(1), ret));
+
+  Reduce();
+
+  // Outer branch should not be rewritten, the inner branch should be discarded.
+  EXPECT_THAT(outer_branch, IsBranch(condition1, graph()->start()));
+  EXPECT_THAT(inner_phi,
+              IsPhi(MachineRepresentation::kWord32, IsInt32Constant(1),
+                    IsInt32Constant(2), IsMerge(IsDead(), outer_if_true)));
+}
+
+
 TEST_F(BranchEliminationTest, NestedBranchSameFalse) {
   // { return (x ? 1 : (x ? 2 : 3); }
   // should be reduced to
@@ -219,6 +219,149 @@ TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldTagged) {
 }
 
 
+TARGET_TEST_P(ChangeLoweringCommonTest, StoreFieldTaggedIntoFreshAllocation) {
+  FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Tagged());
+  Node* alloc = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                 Int32Constant(FixedArray::SizeFor(1)),
+                                 graph()->start(), graph()->start());
+  Node* store = graph()->NewNode(simplified()->StoreField(access), alloc, p0,
+                                 alloc, graph()->start());
+  Reduction r = Reduce(store);
+
+  ASSERT_TRUE(r.Changed());
+  EXPECT_THAT(r.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kNoWriteBarrier),
+                      alloc, IsIntPtrConstant(access.offset - access.tag()),
+                      p0, alloc, graph()->start()));
+}
+
+
+TARGET_TEST_P(ChangeLoweringCommonTest,
+              StoreFieldBoxedNumberIntoFreshAllocation) {
+  FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Number());
+  Node* alloc = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                 Int32Constant(FixedArray::SizeFor(1)),
+                                 graph()->start(), graph()->start());
+  Reduction r1 =
+      Reduce(graph()->NewNode(simplified()->ChangeFloat64ToTagged(), p0));
+  ASSERT_TRUE(r1.Changed());
+  Node* store =
+      graph()->NewNode(simplified()->StoreField(access), alloc,
+                       r1.replacement(), alloc, graph()->start());
+  Reduction r2 = Reduce(store);
+
+  // The HeapNumber for the value is allocated right before the store, which
+  // may trigger a GC that promotes the {alloc}.
+  ASSERT_TRUE(r2.Changed());
+  EXPECT_THAT(r2.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kFullWriteBarrier),
+                      alloc, IsIntPtrConstant(access.offset - access.tag()),
+                      r1.replacement(), alloc, graph()->start()));
+}
+
+
+TARGET_TEST_P(ChangeLoweringCommonTest, FoldAllocation) {
+  bool old_allocation_folding = FLAG_turbo_allocation_folding;
+  FLAG_turbo_allocation_folding = true;
+  FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Tagged());
+  Node* begin1 = graph()->NewNode(common()->BeginRegion(), graph()->start());
+  Node* alloc1 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(16), begin1,
+                                  graph()->start());
+  Node* finish1 = graph()->NewNode(common()->FinishRegion(), alloc1, alloc1);
+  Node* begin2 = graph()->NewNode(common()->BeginRegion(), finish1);
+  Node* alloc2 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(24), begin2,
+                                  graph()->start());
+  Node* store = graph()->NewNode(simplified()->StoreField(access), alloc2, p0,
+                                 alloc2, graph()->start());
+  graph()->NewNode(common()->FinishRegion(), alloc2, store);
+
+  Reduction r1 = Reduce(alloc1);
+  Reduction r2 = Reduce(alloc2);
+  FLAG_turbo_allocation_folding = old_allocation_folding;
+  ASSERT_TRUE(r1.Changed());
+  ASSERT_TRUE(r2.Changed());
+
+  // The first allocation now covers both objects, and the space for the
+  // second object is a filler until it is initialized.
+  EXPECT_THAT(alloc1->InputAt(1), IsNumberConstant(BitEq(40.0)));
+  EXPECT_THAT(NodeProperties::GetEffectInput(finish1),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kNoWriteBarrier),
+                      alloc1, IsIntPtrConstant(16 + FreeSpace::kSizeOffset -
+                                               kHeapObjectTag),
+                      _, IsStore(_, alloc1,
+                                 IsIntPtrConstant(16 - kHeapObjectTag),
+                                 IsHeapConstant(factory()->free_space_map()),
+                                 alloc1, graph()->start()),
+                      graph()->start()));
+
+  // The second object is addressed relative to the first one.
+  Node* inner = r2.replacement();
+  ASSERT_EQ(IrOpcode::kGuard, inner->opcode());
+  EXPECT_THAT(inner->InputAt(0),
+              Is64() ? IsInt64Add(finish1, IsInt64Constant(16))
+                     : IsInt32Add(finish1, IsInt32Constant(16)));
+  EXPECT_EQ(begin2, NodeProperties::GetEffectInput(store));
+
+  // Stores into the second object don't need a write barrier either.
+  store->ReplaceInput(0, inner);
+  Reduction r3 = Reduce(store);
+  ASSERT_TRUE(r3.Changed());
+  EXPECT_THAT(r3.replacement(),
+              IsStore(StoreRepresentation(MachineRepresentation::kTagged,
+                                          kNoWriteBarrier),
+                      inner, IsIntPtrConstant(access.offset - access.tag()),
+                      p0, begin2, graph()->start()));
+}
+
+
+TARGET_TEST_P(ChangeLoweringCommonTest, DontFoldAcrossFloatingAllocation) {
+  bool old_allocation_folding = FLAG_turbo_allocation_folding;
+  FLAG_turbo_allocation_folding = true;
+  FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
+                        Handle<Name>::null(), Type::Any(),
+                        MachineType::AnyTagged()};
+  Node* p0 = Parameter(Type::Number());
+  Node* begin1 = graph()->NewNode(common()->BeginRegion(), graph()->start());
+  Node* alloc1 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(16), begin1,
+                                  graph()->start());
+  Node* finish1 = graph()->NewNode(common()->FinishRegion(), alloc1, alloc1);
+  Reduction r0 =
+      Reduce(graph()->NewNode(simplified()->ChangeFloat64ToTagged(), p0));
+  ASSERT_TRUE(r0.Changed());
+  Node* store = graph()->NewNode(simplified()->StoreField(access), finish1,
+                                 r0.replacement(), finish1, graph()->start());
+  Node* alloc2 = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                  NumberConstant(24), store, graph()->start());
+
+  Reduction r1 = Reduce(alloc1);
+  Reduction r2 = Reduce(alloc2);
+  FLAG_turbo_allocation_folding = old_allocation_folding;
+
+  // The HeapNumber stored in between may trigger a GC, so the second
+  // allocation is not folded into the first one.
+  ASSERT_TRUE(r1.Changed());
+  ASSERT_TRUE(r2.Changed());
+  EXPECT_THAT(alloc1->InputAt(1), IsNumberConstant(BitEq(16.0)));
+  EXPECT_EQ(IrOpcode::kCall, r2.replacement()->opcode());
+
+}
+
+
 TARGET_TEST_P(ChangeLoweringCommonTest, LoadField) {
   FieldAccess access = {kTaggedBase, FixedArrayBase::kHeaderSize,
                         Handle<Name>::null(), Type::Any(),
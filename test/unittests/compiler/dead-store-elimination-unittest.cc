@@ -0,0 +1,118 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/dead-store-elimination.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class DeadStoreEliminationTest : public GraphTest {
+ public:
+  DeadStoreEliminationTest() : GraphTest(3), simplified_(zone()) {}
+  ~DeadStoreEliminationTest() override {}
+
+ protected:
+  Reduction Reduce(Node* node) {
+    GraphReducer graph_reducer(zone(), graph());
+    DeadStoreElimination reducer(&graph_reducer);
+    return reducer.Reduce(node);
+  }
+
+  Node* StoreField(FieldAccess const& access, Node* object, Node* value,
+                   Node* effect) {
+    return graph()->NewNode(simplified()->StoreField(access), object, value,
+                            effect, graph()->start());
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(DeadStoreEliminationTest, StoreFieldOverwritten) {
+  Node* object = Parameter(0);
+  Node* value1 = Parameter(1);
+  Node* value2 = Parameter(2);
+  FieldAccess const access1 = AccessBuilder::ForJSObjectProperties();
+  FieldAccess const access2 = AccessBuilder::ForJSObjectElements();
+
+  Node* store1 = StoreField(access1, object, value1, graph()->start());
+  Node* store2 = StoreField(access2, object, value1, store1);
+  Node* store3 = StoreField(access1, object, value2, store2);
+
+  Reduction r = Reduce(store3);
+  ASSERT_FALSE(r.Changed());
+  EXPECT_EQ(graph()->start(), NodeProperties::GetEffectInput(store2));
+  EXPECT_EQ(store2, NodeProperties::GetEffectInput(store3));
+}
+
+
+TEST_F(DeadStoreEliminationTest, StoreFieldObservedByLoad) {
+  Node* object1 = Parameter(0);
+  Node* object2 = Parameter(1);
+  Node* value = Parameter(2);
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+
+  Node* store1 = StoreField(access, object1, value, graph()->start());
+  // The load might read the field through an alias of {object1}.
+  Node* load = graph()->NewNode(simplified()->LoadField(access), object2,
+                                store1, graph()->start());
+  Node* store2 = StoreField(access, object1, value, load);
+
+  Reduce(store2);
+  EXPECT_EQ(store1, NodeProperties::GetEffectInput(load));
+}
+
+
+TEST_F(DeadStoreEliminationTest, StoreFieldObservedByOtherEffectUse) {
+  Node* object = Parameter(0);
+  Node* value = Parameter(1);
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+
+  Node* store1 = StoreField(access, object, value, graph()->start());
+  Node* store2 = StoreField(access, object, value, store1);
+  // Another effect use of {store1}, i.e. a deoptimization point.
+  Node* ret = graph()->NewNode(common()->Return(), value, store1,
+                               graph()->start());
+
+  Reduce(store2);
+  EXPECT_EQ(store1, NodeProperties::GetEffectInput(store2));
+  EXPECT_EQ(store1, NodeProperties::GetEffectInput(ret));
+}
+
+
+TEST_F(DeadStoreEliminationTest, StoreFieldInitializingStoreKept) {
+  Node* value1 = Parameter(0);
+  Node* value2 = Parameter(1);
+  FieldAccess const access = AccessBuilder::ForJSObjectProperties();
+
+  Node* begin = graph()->NewNode(common()->BeginRegion(), graph()->start());
+  Node* allocate = graph()->NewNode(simplified()->Allocate(NOT_TENURED),
+                                    NumberConstant(16), begin,
+                                    graph()->start());
+  Node* store1 = StoreField(access, allocate, value1, allocate);
+  Node* finish = graph()->NewNode(common()->FinishRegion(), allocate, store1);
+  // Lowering the change allocates a HeapNumber box that is scheduled between
+  // the allocation and {store2}, so the field must be initialized already.
+  Node* change =
+      graph()->NewNode(simplified()->ChangeFloat64ToTagged(), value2);
+  Node* store2 = StoreField(access, finish, change, finish);
+
+  Reduction r = Reduce(store2);
+  ASSERT_FALSE(r.Changed());
+  EXPECT_EQ(store1, NodeProperties::GetEffectInput(finish));
+  EXPECT_EQ(finish, NodeProperties::GetEffectInput(store2));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
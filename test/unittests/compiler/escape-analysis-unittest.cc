@@ -108,6 +108,34 @@ class EscapeAnalysisTest : public GraphTest {
                graph()->NewNode(common()->Return(), value, effect, control);
   }
 
+  Node* StateValues(Node* value) {
+    return graph()->NewNode(common()->StateValues(1), value);
+  }
+
+  Node* FrameState(Node* state_values, Node* outer_frame_state = nullptr) {
+    if (!outer_frame_state) {
+      outer_frame_state = graph()->start();
+    }
+    return graph()->NewNode(
+        common()->FrameState(BailoutId::None(),
+                             OutputFrameStateCombine::Ignore(), nullptr),
+        state_values, state_values, state_values, Constant(0), Constant(0),
+        outer_frame_state);
+  }
+
+  Node* Deoptimize(Node* frame_state, Node* effect = nullptr,
+                   Node* control = nullptr) {
+    if (!effect) {
+      effect = effect_;
+    }
+    if (!control) {
+      control = control_;
+    }
+    return control_ =
+               graph()->NewNode(common()->Deoptimize(DeoptimizeKind::kEager),
+                                frame_state, effect, control);
+  }
+
   void EndGraph() {
     for (Edge edge : graph()->end()->input_edges()) {
       if (NodeProperties::IsControlEdge(edge)) {
@@ -131,6 +159,12 @@ class EscapeAnalysisTest : public GraphTest {
     return control_ = graph()->NewNode(common()->Merge(2), control1, control2);
   }
 
+  Node* MapConstant() {
+    Handle<Map> map =
+        isolate()->factory()->NewMap(JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    return graph()->NewNode(common()->HeapConstant(map));
+  }
+
   FieldAccess AccessAtIndex(int offset) {
     FieldAccess access = {kTaggedBase, offset, MaybeHandle<Name>(), Type::Any(),
                           MachineType::AnyTagged()};
@@ -300,6 +334,61 @@ TEST_F(EscapeAnalysisTest, DanglingLoadOrder) {
   ASSERT_EQ(object1, NodeProperties::GetValueInput(result, 0));
 }
 
+
+TEST_F(EscapeAnalysisTest, DeoptReplacement) {
+  Node* map = MapConstant();
+  Node* object1 = Constant(1);
+  Node* object2 = Constant(2);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(JSObject::kHeaderSize));
+  Store(AccessAtIndex(HeapObject::kMapOffset), allocation, map);
+  Store(AccessAtIndex(JSObject::kPropertiesOffset), allocation, object1);
+  Store(AccessAtIndex(JSObject::kElementsOffset), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Store(AccessAtIndex(JSObject::kElementsOffset), finish, object2);
+  Node* frame_state = FrameState(StateValues(finish));
+  Node* deopt = Deoptimize(frame_state);
+  EndGraph();
+  Analysis();
+
+  ExpectVirtual(allocation);
+
+  Transformation();
+
+  Node* state_values =
+      NodeProperties::GetValueInput(NodeProperties::GetValueInput(deopt, 0), 0);
+  ASSERT_EQ(IrOpcode::kStateValues, state_values->opcode());
+  Node* object_state = NodeProperties::GetValueInput(state_values, 0);
+  ASSERT_EQ(IrOpcode::kObjectState, object_state->opcode());
+  ASSERT_EQ(3, object_state->op()->ValueInputCount());
+  EXPECT_EQ(map, NodeProperties::GetValueInput(object_state, 0));
+  EXPECT_EQ(object1, NodeProperties::GetValueInput(object_state, 1));
+  EXPECT_EQ(object2, NodeProperties::GetValueInput(object_state, 2));
+}
+
+
+TEST_F(EscapeAnalysisTest, DeoptUnknownMapEscape) {
+  Node* object1 = Constant(1);
+  BeginRegion();
+  Node* allocation = Allocate(Constant(JSObject::kHeaderSize));
+  Store(AccessAtIndex(HeapObject::kMapOffset), allocation, object1);
+  Store(AccessAtIndex(JSObject::kPropertiesOffset), allocation, object1);
+  Store(AccessAtIndex(JSObject::kElementsOffset), allocation, object1);
+  Node* finish = FinishRegion(allocation);
+  Node* frame_state = FrameState(StateValues(finish));
+  Node* deopt = Deoptimize(frame_state);
+  EndGraph();
+  Analysis();
+
+  ExpectEscaped(allocation);
+
+  Transformation();
+
+  Node* state_values =
+      NodeProperties::GetValueInput(NodeProperties::GetValueInput(deopt, 0), 0);
+  ASSERT_EQ(finish, NodeProperties::GetValueInput(state_values, 0));
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -146,9 +146,13 @@ TARGET_TEST_F(InterpreterAssemblerTest, Dispatch) {
     m.Dispatch();
     Graph* graph = m.graph();
 
+    // Handlers which look ahead for a Star have an additional tail call for
+    // the inlined Star, which comes first.
+    int dispatch_count =
+        interpreter::Bytecodes::IsStarLookahead(bytecode) ? 2 : 1;
     Node* end = graph->end();
-    EXPECT_EQ(1, end->InputCount());
-    Node* tail_call_node = end->InputAt(0);
+    EXPECT_EQ(dispatch_count, end->InputCount());
+    Node* tail_call_node = end->InputAt(dispatch_count - 1);
 
     Matcher<Node*> next_bytecode_offset_matcher =
         IsIntPtrAdd(IsParameter(Linkage::kInterpreterBytecodeOffsetParameter),
@@ -178,6 +182,47 @@ TARGET_TEST_F(InterpreterAssemblerTest, Dispatch) {
 }
 
 
+TARGET_TEST_F(InterpreterAssemblerTest, DispatchWithStarLookahead) {
+  TRACED_FOREACH(interpreter::Bytecode, bytecode, kBytecodes) {
+    if (!interpreter::Bytecodes::IsStarLookahead(bytecode)) continue;
+    InterpreterAssemblerForTest m(this, bytecode);
+    m.Dispatch();
+    Graph* graph = m.graph();
+
+    Node* end = graph->end();
+    EXPECT_EQ(2, end->InputCount());
+    Node* tail_call_node = end->InputAt(0);
+
+    Matcher<Node*> star_offset_matcher =
+        IsIntPtrAdd(IsParameter(Linkage::kInterpreterBytecodeOffsetParameter),
+                    IsInt32Constant(interpreter::Bytecodes::Size(bytecode)));
+    Matcher<Node*> next_bytecode_offset_matcher = IsIntPtrAdd(
+        star_offset_matcher,
+        IsInt32Constant(
+            interpreter::Bytecodes::Size(interpreter::Bytecode::kStar)));
+    Matcher<Node*> target_bytecode_matcher =
+        m.IsLoad(MachineType::Uint8(),
+                 IsParameter(Linkage::kInterpreterBytecodeArrayParameter),
+                 next_bytecode_offset_matcher);
+    Matcher<Node*> code_target_matcher =
+        m.IsLoad(MachineType::Pointer(),
+                 IsParameter(Linkage::kInterpreterDispatchTableParameter),
+                 IsWord32Shl(target_bytecode_matcher,
+                             IsInt32Constant(kPointerSizeLog2)));
+
+    EXPECT_THAT(
+        tail_call_node,
+        IsTailCall(m.call_descriptor(), code_target_matcher,
+                   IsParameter(Linkage::kInterpreterAccumulatorParameter),
+                   IsParameter(Linkage::kInterpreterRegisterFileParameter),
+                   next_bytecode_offset_matcher,
+                   IsParameter(Linkage::kInterpreterBytecodeArrayParameter),
+                   IsParameter(Linkage::kInterpreterDispatchTableParameter),
+                   IsParameter(Linkage::kInterpreterContextParameter), _, _));
+  }
+}
+
+
 TARGET_TEST_F(InterpreterAssemblerTest, Jump) {
   int jump_offsets[] = {-9710, -77, 0, +3, +97109};
   TRACED_FOREACH(int, jump_offset, jump_offsets) {
@@ -348,13 +393,15 @@ TARGET_TEST_F(InterpreterAssemblerTest, GetSetAccumulator) {
     m.Dispatch();
     Graph* graph = m.graph();
 
+    int dispatch_count =
+        interpreter::Bytecodes::IsStarLookahead(bytecode) ? 2 : 1;
     Node* end = graph->end();
-    EXPECT_EQ(1, end->InputCount());
-    Node* tail_call_node = end->InputAt(0);
-
-    EXPECT_THAT(tail_call_node,
-                IsTailCall(m.call_descriptor(), _, accumulator_value_2, _, _, _,
-                           _, _, _));
+    EXPECT_EQ(dispatch_count, end->InputCount());
+    for (int i = 0; i < dispatch_count; i++) {
+      EXPECT_THAT(end->InputAt(i),
+                  IsTailCall(m.call_descriptor(), _, accumulator_value_2, _, _,
+                             _, _, _, _));
+    }
   }
 }
 
@@ -7,6 +7,7 @@
 #include "src/compiler/js-graph.h"
 #include "src/compiler/js-intrinsic-lowering.h"
 #include "src/compiler/js-operator.h"
+#include "src/compiler/node-properties.h"
 #include "src/types-inl.h"
 #include "test/unittests/compiler/graph-unittest.h"
 #include "test/unittests/compiler/node-test-utils.h"
@@ -58,6 +59,73 @@ class JSIntrinsicLoweringTest : public TypedGraphTest {
 };
 
 
+// -----------------------------------------------------------------------------
+// %_AtomicsIsLockFree
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineAtomicsIsLockFreeWithConstant) {
+  Node* const context = Parameter(0);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Reduction const r1 = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineAtomicsIsLockFree, 1),
+      NumberConstant(4), context, effect, control));
+  ASSERT_TRUE(r1.Changed());
+  EXPECT_THAT(r1.replacement(), IsTrueConstant());
+  Reduction const r2 = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineAtomicsIsLockFree, 1),
+      NumberConstant(8), context, effect, control));
+  ASSERT_TRUE(r2.Changed());
+  EXPECT_THAT(r2.replacement(), IsFalseConstant());
+}
+
+
+// -----------------------------------------------------------------------------
+// %_AtomicsLoad
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineAtomicsLoad) {
+  Node* const array = Parameter(0);
+  Node* const index = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Reduction const r = Reduce(
+      graph()->NewNode(
+          javascript()->CallRuntime(Runtime::kInlineAtomicsLoad, 2), array,
+          index, context, effect, control),
+      MachineOperatorBuilder::kAtomicLoad);
+  ASSERT_TRUE(r.Changed());
+
+  Node* phi = r.replacement();
+  ASSERT_EQ(IrOpcode::kPhi, phi->opcode());
+  Node* load = NodeProperties::GetValueInput(phi, 0);
+  ASSERT_EQ(IrOpcode::kAtomicLoad, load->opcode());
+  EXPECT_EQ(MachineType::Int32(), LoadRepresentationOf(load->op()));
+  EXPECT_THAT(
+      NodeProperties::GetValueInput(load, 0),
+      IsLoadField(AccessBuilder::ForFixedTypedArrayBaseExternalPointer(),
+                  IsLoadField(AccessBuilder::ForJSObjectElements(), array,
+                              effect, control),
+                  _, _));
+  Node* call = NodeProperties::GetValueInput(phi, 1);
+  EXPECT_EQ(IrOpcode::kJSCallRuntime, call->opcode());
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, InlineAtomicsLoadUnsupported) {
+  Node* const array = Parameter(0);
+  Node* const index = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kInlineAtomicsLoad, 2), array, index,
+      context, effect, control));
+  ASSERT_FALSE(r.Changed());
+}
+
+
 // -----------------------------------------------------------------------------
 // %_ConstructDouble
 
@@ -457,6 +525,55 @@ TEST_F(JSIntrinsicLoweringTest, InlineValueOf) {
               AllOf(CaptureEq(&if_false0), IsIfFalse(CaptureEq(&branch0))))));
 }
 
+
+// -----------------------------------------------------------------------------
+// %Float32x4ExtractLane
+
+
+TEST_F(JSIntrinsicLoweringTest, Float32x4ExtractLaneWithConstantLane) {
+  Node* const input = Parameter(0);
+  Node* const context = Parameter(1);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kFloat32x4ExtractLane, 2), input,
+      NumberConstant(2), context, EmptyFrameState(), effect, control));
+  ASSERT_TRUE(r.Changed());
+
+  Node* phi = r.replacement();
+  Capture<Node*> if_true, value_map;
+  EXPECT_THAT(
+      phi,
+      IsPhi(MachineRepresentation::kTagged,
+            IsLoadField(AccessBuilder::ForSimd128Lane(2, 4, Type::Any(),
+                                                      MachineType::Float32()),
+                        input, CaptureEq(&value_map), CaptureEq(&if_true)),
+            _,
+            IsMerge(AllOf(CaptureEq(&if_true),
+                          IsIfTrue(IsBranch(
+                              IsReferenceEqual(
+                                  _,
+                                  AllOf(CaptureEq(&value_map),
+                                        IsLoadField(AccessBuilder::ForMap(),
+                                                    input, effect, _)),
+                                  IsHeapConstant(factory()->float32x4_map())),
+                              _))),
+                    _)));
+}
+
+
+TEST_F(JSIntrinsicLoweringTest, Float32x4ExtractLaneWithVariableLane) {
+  Node* const input = Parameter(0);
+  Node* const lane = Parameter(1);
+  Node* const context = Parameter(2);
+  Node* const effect = graph()->start();
+  Node* const control = graph()->start();
+  Reduction const r = Reduce(graph()->NewNode(
+      javascript()->CallRuntime(Runtime::kFloat32x4ExtractLane, 2), input,
+      lane, context, EmptyFrameState(), effect, control));
+  ASSERT_FALSE(r.Changed());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -69,6 +69,45 @@ TEST_F(LoadEliminationTest, LoadFieldWithStoreField) {
   EXPECT_EQ(value, r4.replacement());
 }
 
+
+TEST_F(LoadEliminationTest, LoadFieldThroughDiamond) {
+  Node* object = Parameter(0);
+  Node* value = Parameter(1);
+  Node* condition = Parameter(2);
+  Node* effect = graph()->start();
+  Node* control = graph()->start();
+
+  FieldAccess const map_access = AccessBuilder::ForMap();
+  Node* load1 = effect = graph()->NewNode(
+      simplified()->LoadField(map_access), object, effect, control);
+
+  Node* branch = graph()->NewNode(common()->Branch(), condition, control);
+  Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+  Node* etrue = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectProperties()), object,
+      value, effect, if_true);
+  Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+  Node* efalse = graph()->NewNode(
+      simplified()->LoadField(AccessBuilder::ForJSObjectElements()), object,
+      effect, if_false);
+  control = graph()->NewNode(common()->Merge(2), if_true, if_false);
+  effect = graph()->NewNode(common()->EffectPhi(2), etrue, efalse, control);
+
+  Reduction r1 = Reduce(graph()->NewNode(simplified()->LoadField(map_access),
+                                         object, effect, control));
+  ASSERT_TRUE(r1.Changed());
+  EXPECT_EQ(load1, r1.replacement());
+
+  // A store to the map on one of the paths invalidates the value.
+  Node* estore = graph()->NewNode(simplified()->StoreField(map_access),
+                                  object, value, etrue, if_true);
+  Node* effect2 =
+      graph()->NewNode(common()->EffectPhi(2), estore, efalse, control);
+  Reduction r2 = Reduce(graph()->NewNode(simplified()->LoadField(map_access),
+                                         object, effect2, control));
+  ASSERT_FALSE(r2.Changed());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,137 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/js-operator.h"
+#include "src/compiler/loop-invariant-code-motion.h"
+#include "src/compiler/node.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopInvariantCodeMotionTest : public GraphTest {
+ public:
+  LoopInvariantCodeMotionTest()
+      : GraphTest(1), javascript_(zone()), simplified_(zone()) {}
+  ~LoopInvariantCodeMotionTest() override {}
+
+ protected:
+  // The skeleton of a loop "while (cond) { ... }"; the body is wired up by
+  // the individual tests.
+  struct While {
+    Node* loop;
+    Node* effect_phi;
+    Node* branch;
+    Node* if_true;
+    Node* if_false;
+  };
+
+  While NewWhile(Node* cond) {
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* branch = graph()->NewNode(common()->Branch(), cond, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    loop->ReplaceInput(1, if_true);
+    return {loop, effect_phi, branch, if_true, if_false};
+  }
+
+  Node* NewLoadField(Node* object, Node* effect, Node* control) {
+    return graph()->NewNode(
+        simplified()->LoadField(AccessBuilder::ForJSObjectProperties()),
+        object, effect, control);
+  }
+
+  void Finish(While const& w, Node* value, Node* effect) {
+    w.effect_phi->ReplaceInput(1, effect);
+    graph()->SetEnd(graph()->NewNode(common()->Return(), value, w.effect_phi,
+                                     w.if_false));
+  }
+
+  void Optimize() {
+    LoopInvariantCodeMotion licm(graph(), zone());
+    licm.Run();
+  }
+
+  JSOperatorBuilder* javascript() { return &javascript_; }
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  JSOperatorBuilder javascript_;
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(LoopInvariantCodeMotionTest, HoistLoadFromReadOnlyLoop) {
+  Node* object = Parameter(0);
+  While w = NewWhile(Parameter(0));
+  Node* load = NewLoadField(object, w.effect_phi, w.loop);
+  Finish(w, load, load);
+
+  Optimize();
+
+  EXPECT_EQ(start(), NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(start(), NodeProperties::GetControlInput(load));
+  EXPECT_EQ(load, w.effect_phi->InputAt(0));
+  EXPECT_EQ(w.effect_phi, w.effect_phi->InputAt(1));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, DontHoistLoadFromWritingLoop) {
+  Node* object = Parameter(0);
+  While w = NewWhile(Parameter(0));
+  Node* load = NewLoadField(object, w.effect_phi, w.loop);
+  Node* store = graph()->NewNode(
+      simplified()->StoreField(AccessBuilder::ForJSObjectProperties()),
+      object, load, load, w.if_true);
+  Finish(w, load, store);
+
+  Optimize();
+
+  EXPECT_EQ(w.effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(w.loop, NodeProperties::GetControlInput(load));
+  EXPECT_EQ(start(), w.effect_phi->InputAt(0));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, DontHoistLoadAcrossStackCheck) {
+  Node* object = Parameter(0);
+  While w = NewWhile(Parameter(0));
+  Node* load = NewLoadField(object, w.effect_phi, w.loop);
+  // The stack check can call into the runtime, which may run arbitrary code.
+  Node* stack_check =
+      graph()->NewNode(javascript()->StackCheck(), UndefinedConstant(),
+                       EmptyFrameState(), load, w.if_true);
+  Finish(w, load, stack_check);
+
+  Optimize();
+
+  EXPECT_EQ(w.effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(w.loop, NodeProperties::GetControlInput(load));
+  EXPECT_EQ(start(), w.effect_phi->InputAt(0));
+}
+
+
+TEST_F(LoopInvariantCodeMotionTest, DontHoistConditionalLoad) {
+  Node* object = Parameter(0);
+  While w = NewWhile(Parameter(0));
+  Node* load = NewLoadField(object, w.effect_phi, w.if_true);
+  Finish(w, load, load);
+
+  Optimize();
+
+  EXPECT_EQ(w.effect_phi, NodeProperties::GetEffectInput(load));
+  EXPECT_EQ(w.if_true, NodeProperties::GetControlInput(load));
+  EXPECT_EQ(start(), w.effect_phi->InputAt(0));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
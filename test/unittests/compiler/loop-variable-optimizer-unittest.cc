@@ -0,0 +1,182 @@
+// Copyright 2016 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/access-builder.h"
+#include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/node.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/simplified-operator.h"
+#include "test/unittests/compiler/graph-unittest.h"
+#include "test/unittests/compiler/node-test-utils.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class LoopVariableOptimizerTest : public GraphTest {
+ public:
+  LoopVariableOptimizerTest() : GraphTest(2), simplified_(zone()) {}
+  ~LoopVariableOptimizerTest() override {}
+
+ protected:
+  // A loop of the form
+  //
+  //   for (phi = initial; cmp(phi, bound); phi = arith(phi, increment)) {
+  //     load = array[phi];
+  //   }
+  //   return phi;
+  struct CountingLoop {
+    Node* loop;
+    Node* phi;
+    Node* arith;
+    Node* if_true;
+    Node* load;
+    Node* ret;
+  };
+
+  CountingLoop NewCountingLoop(Node* initial, Node* increment, Node* bound,
+                               const Operator* cmp_op,
+                               const Operator* arith_op, bool swap = false) {
+    Node* array = Parameter(0);
+    Node* loop = graph()->NewNode(common()->Loop(2), start(), start());
+    Node* phi =
+        graph()->NewNode(common()->Phi(MachineRepresentation::kTagged, 2),
+                         initial, initial, loop);
+    Node* effect_phi =
+        graph()->NewNode(common()->EffectPhi(2), start(), start(), loop);
+    Node* cmp = swap ? graph()->NewNode(cmp_op, bound, phi)
+                     : graph()->NewNode(cmp_op, phi, bound);
+    Node* branch = graph()->NewNode(common()->Branch(), cmp, loop);
+    Node* if_true = graph()->NewNode(common()->IfTrue(), branch);
+    Node* if_false = graph()->NewNode(common()->IfFalse(), branch);
+    Node* load = graph()->NewNode(
+        simplified()->LoadElement(AccessBuilder::ForFixedArrayElement()),
+        array, phi, effect_phi, if_true);
+    Node* arith = graph()->NewNode(arith_op, phi, increment);
+    loop->ReplaceInput(1, if_true);
+    phi->ReplaceInput(1, arith);
+    effect_phi->ReplaceInput(1, load);
+    Node* ret =
+        graph()->NewNode(common()->Return(), phi, effect_phi, if_false);
+    graph()->SetEnd(ret);
+    return {loop, phi, arith, if_true, load, ret};
+  }
+
+  // Types the graph with the help of the {optimizer}, and inserts the
+  // guards while the typer is still around to type them.
+  void Optimize(LoopVariableOptimizer* optimizer) {
+    Typer typer(isolate(), graph());
+    optimizer->Run();
+    typer.Run(NodeVector(zone()), optimizer);
+    optimizer->InsertGuards();
+  }
+
+  SimplifiedOperatorBuilder* simplified() { return &simplified_; }
+
+ private:
+  SimplifiedOperatorBuilder simplified_;
+};
+
+
+TEST_F(LoopVariableOptimizerTest, DetectIncreasingInductionVariable) {
+  Node* initial = NumberConstant(0.0);
+  Node* increment = NumberConstant(1.0);
+  Node* bound = NumberConstant(100.0);
+  CountingLoop w = NewCountingLoop(initial, increment, bound,
+                                   simplified()->NumberLessThan(),
+                                   simplified()->NumberAdd());
+
+  LoopVariableOptimizer optimizer(graph(), common(), zone());
+  optimizer.Run();
+
+  InductionVariable* var = optimizer.GetInductionVariable(w.phi);
+  ASSERT_TRUE(var != nullptr);
+  EXPECT_EQ(w.phi, var->phi());
+  EXPECT_EQ(w.arith, var->arith());
+  EXPECT_EQ(initial, var->init_value());
+  EXPECT_EQ(increment, var->increment());
+  EXPECT_EQ(InductionVariable::kAddition, var->arithmetic_type());
+  ASSERT_EQ(1u, var->upper_bounds().size());
+  EXPECT_EQ(bound, var->upper_bounds()[0].bound);
+  EXPECT_EQ(InductionVariable::kStrict, var->upper_bounds()[0].kind);
+  EXPECT_TRUE(var->lower_bounds().empty());
+}
+
+
+TEST_F(LoopVariableOptimizerTest, TypeIncreasingInductionVariable) {
+  CountingLoop w = NewCountingLoop(NumberConstant(0.0), NumberConstant(1.0),
+                                   NumberConstant(100.0),
+                                   simplified()->NumberLessThan(),
+                                   simplified()->NumberAdd());
+
+  LoopVariableOptimizer optimizer(graph(), common(), zone());
+  Optimize(&optimizer);
+
+  // The phi also takes the value that fails the check.
+  Type* phi_type = NodeProperties::GetType(w.phi);
+  EXPECT_TRUE(phi_type->Is(Type::Range(0.0, 100.0, zone())));
+  EXPECT_TRUE(Type::Range(0.0, 100.0, zone())->Is(phi_type));
+}
+
+
+TEST_F(LoopVariableOptimizerTest, TypeDecreasingInductionVariable) {
+  // for (i = 100; 0 <= i; i = i - 2)
+  CountingLoop w = NewCountingLoop(
+      NumberConstant(100.0), NumberConstant(2.0), NumberConstant(0.0),
+      simplified()->NumberLessThanOrEqual(), simplified()->NumberSubtract(),
+      true);
+
+  LoopVariableOptimizer optimizer(graph(), common(), zone());
+  Optimize(&optimizer);
+
+  InductionVariable* var = optimizer.GetInductionVariable(w.phi);
+  ASSERT_TRUE(var != nullptr);
+  EXPECT_EQ(InductionVariable::kSubtraction, var->arithmetic_type());
+  ASSERT_EQ(1u, var->lower_bounds().size());
+  EXPECT_EQ(InductionVariable::kNonStrict, var->lower_bounds()[0].kind);
+
+  Type* phi_type = NodeProperties::GetType(w.phi);
+  EXPECT_TRUE(phi_type->Is(Type::Range(-2.0, 100.0, zone())));
+}
+
+
+TEST_F(LoopVariableOptimizerTest, GuardUsesDominatedByCheck) {
+  CountingLoop w = NewCountingLoop(NumberConstant(0.0), NumberConstant(1.0),
+                                   NumberConstant(100.0),
+                                   simplified()->NumberLessThan(),
+                                   simplified()->NumberAdd());
+
+  LoopVariableOptimizer optimizer(graph(), common(), zone());
+  Optimize(&optimizer);
+
+  // The index of the load inside the loop is known to be in bounds.
+  Node* index = NodeProperties::GetValueInput(w.load, 1);
+  ASSERT_EQ(IrOpcode::kGuard, index->opcode());
+  EXPECT_EQ(w.phi, NodeProperties::GetValueInput(index, 0));
+  EXPECT_EQ(w.if_true, NodeProperties::GetControlInput(index));
+  EXPECT_TRUE(
+      NodeProperties::GetType(index)->Is(Type::Range(0.0, 99.0, zone())));
+
+  // Uses outside of the loop body, and uses without control, are unchanged.
+  EXPECT_EQ(w.phi, NodeProperties::GetValueInput(w.ret, 0));
+  EXPECT_EQ(w.phi, NodeProperties::GetValueInput(w.arith, 0));
+}
+
+
+TEST_F(LoopVariableOptimizerTest, NoInductionVariableWithoutIncrement) {
+  CountingLoop w = NewCountingLoop(NumberConstant(0.0), NumberConstant(2.0),
+                                   NumberConstant(100.0),
+                                   simplified()->NumberLessThan(),
+                                   simplified()->NumberMultiply());
+
+  LoopVariableOptimizer optimizer(graph(), common(), zone());
+  Optimize(&optimizer);
+
+  EXPECT_EQ(nullptr, optimizer.GetInductionVariable(w.phi));
+  EXPECT_EQ(w.phi, NodeProperties::GetValueInput(w.load, 1));
+}
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -96,6 +96,25 @@ TEST_P(MachineLoadOperatorTest, ParameterIsCorrect) {
 }
 
 
+TEST_P(MachineLoadOperatorTest, AtomicLoadIsOptional) {
+  MachineOperatorBuilder machine1(zone(), representation());
+  EXPECT_FALSE(machine1.AtomicLoad(GetParam()).IsSupported());
+
+  MachineOperatorBuilder machine2(zone(), representation(),
+                                  MachineOperatorBuilder::kAtomicLoad);
+  const Operator* op = machine2.AtomicLoad(GetParam()).op();
+  EXPECT_EQ(IrOpcode::kAtomicLoad, op->opcode());
+  EXPECT_EQ(GetParam(), OpParameter<LoadRepresentation>(op));
+  EXPECT_EQ(2, op->ValueInputCount());
+  EXPECT_EQ(1, op->EffectInputCount());
+  EXPECT_EQ(1, op->ControlInputCount());
+  EXPECT_EQ(1, op->ValueOutputCount());
+  EXPECT_EQ(1, op->EffectOutputCount());
+  EXPECT_EQ(0, op->ControlOutputCount());
+  EXPECT_FALSE(op->HasProperty(Operator::kNoWrite));
+}
+
+
 INSTANTIATE_TEST_CASE_P(
     MachineOperatorTest, MachineLoadOperatorTest,
     ::testing::Combine(::testing::ValuesIn(kMachineReps),
@@ -701,6 +701,37 @@ TEST_F(RegisterAllocatorTest, MultipleDeferredBlockSpills) {
 }
 
 
+TEST_F(RegisterAllocatorTest, AdaptiveAllocatorChoice) {
+  bool old_greedy = FLAG_turbo_greedy_regalloc;
+  bool old_adaptive = FLAG_turbo_adaptive_regalloc;
+  int old_max_size = FLAG_turbo_greedy_regalloc_max_size;
+  FLAG_turbo_greedy_regalloc = false;
+  FLAG_turbo_greedy_regalloc_max_size = 100;
+
+  // Without the flag, linear scan is used regardless of the size.
+  FLAG_turbo_adaptive_regalloc = false;
+  EXPECT_FALSE(Pipeline::UseGreedyAllocator(true, 10));
+
+  // Optimized functions use the greedy allocator up to the maximum size.
+  FLAG_turbo_adaptive_regalloc = true;
+  EXPECT_TRUE(Pipeline::UseGreedyAllocator(true, 0));
+  EXPECT_TRUE(Pipeline::UseGreedyAllocator(true, 100));
+  EXPECT_FALSE(Pipeline::UseGreedyAllocator(true, 101));
+
+  // Stubs always use linear scan.
+  EXPECT_FALSE(Pipeline::UseGreedyAllocator(false, 10));
+
+  // --turbo-greedy-regalloc forces the greedy allocator everywhere.
+  FLAG_turbo_greedy_regalloc = true;
+  EXPECT_TRUE(Pipeline::UseGreedyAllocator(false, 10));
+  EXPECT_TRUE(Pipeline::UseGreedyAllocator(true, 101));
+
+  FLAG_turbo_greedy_regalloc = old_greedy;
+  FLAG_turbo_adaptive_regalloc = old_adaptive;
+  FLAG_turbo_greedy_regalloc_max_size = old_max_size;
+}
+
+
 namespace {
 
 enum class ParameterType { kFixedSlot, kSlot, kRegister, kFixedRegister };
@@ -49,6 +49,7 @@
         'compiler/control-equivalence-unittest.cc',
         'compiler/control-flow-optimizer-unittest.cc',
         'compiler/dead-code-elimination-unittest.cc',
+        'compiler/dead-store-elimination-unittest.cc',
         'compiler/diamond-unittest.cc',
         'compiler/escape-analysis-unittest.cc',
         'compiler/graph-reducer-unittest.cc',
@@ -71,7 +72,9 @@
         'compiler/liveness-analyzer-unittest.cc',
         'compiler/live-range-unittest.cc',
         'compiler/load-elimination-unittest.cc',
+        'compiler/loop-invariant-code-motion-unittest.cc',
         'compiler/loop-peeling-unittest.cc',
+        'compiler/loop-variable-optimizer-unittest.cc',
         'compiler/machine-operator-reducer-unittest.cc',
         'compiler/machine-operator-unittest.cc',
         'compiler/move-optimizer-unittest.cc',
@@ -504,6 +504,8 @@
         '../../src/compiler/control-flow-optimizer.h',
         '../../src/compiler/dead-code-elimination.cc',
         '../../src/compiler/dead-code-elimination.h',
+        '../../src/compiler/dead-store-elimination.cc',
+        '../../src/compiler/dead-store-elimination.h',
         '../../src/compiler/diamond.h',
         '../../src/compiler/escape-analysis.cc',
         '../../src/compiler/escape-analysis.h',
@@ -581,8 +583,12 @@
         '../../src/compiler/load-elimination.h',
         '../../src/compiler/loop-analysis.cc',
         '../../src/compiler/loop-analysis.h',
+        '../../src/compiler/loop-invariant-code-motion.cc',
+        '../../src/compiler/loop-invariant-code-motion.h',
         '../../src/compiler/loop-peeling.cc',
         '../../src/compiler/loop-peeling.h',
+        '../../src/compiler/loop-variable-optimizer.cc',
+        '../../src/compiler/loop-variable-optimizer.h',
         '../../src/compiler/machine-operator-reducer.cc',
         '../../src/compiler/machine-operator-reducer.h',
         '../../src/compiler/machine-operator.cc',
@@ -906,6 +912,8 @@
         '../../src/parsing/func-name-inferrer.cc',
         '../../src/parsing/func-name-inferrer.h',
         '../../src/parsing/json-parser.h',
+        '../../src/parsing/parallel-preparser.cc',
+        '../../src/parsing/parallel-preparser.h',
         '../../src/parsing/parameter-initializer-rewriter.cc',
         '../../src/parsing/parameter-initializer-rewriter.h',
         '../../src/parsing/parser.cc',
@@ -0,0 +1,141 @@
+#! /usr/bin/python
+#
+# Copyright 2016 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+
+"""Summarizes the bytecode dispatch counters written by d8 when run with
+--ignition --trace-ignition-dispatches."""
+
+import argparse
+import json
+
+
+__DESCRIPTION = """
+Process the interpreter dispatch counters written by
+--trace-ignition-dispatches. The counters file holds a JSON object of the form
+{"source bytecode": {"destination bytecode": count}}.
+"""
+
+__HELP_EPILOGUE = """
+examples:
+  # Print the 20 most frequently dispatched bytecodes.
+  $ tools/ignition/bytecode_dispatches_report.py -n 20
+
+  # Print the 20 most frequent (source, destination) bytecode pairs.
+  $ tools/ignition/bytecode_dispatches_report.py -p -n 20
+
+  # Print the bytecodes most frequently dispatched to from Ldar.
+  $ tools/ignition/bytecode_dispatches_report.py -f Ldar
+
+  # Print the bytecodes which most frequently dispatch to Star.
+  $ tools/ignition/bytecode_dispatches_report.py -t Star
+"""
+
+
+def sorted_counts(counts):
+  return sorted(counts.items(), key=lambda (name, count): count, reverse=True)
+
+
+def bytecode_counts(dispatches_table):
+  counts = {}
+  for destinations in dispatches_table.values():
+    for destination, count in destinations.items():
+      counts[destination] = counts.get(destination, 0) + count
+  return counts
+
+
+def pair_counts(dispatches_table):
+  counts = {}
+  for source, destinations in dispatches_table.items():
+    for destination, count in destinations.items():
+      counts["{} -> {}".format(source, destination)] = count
+  return counts
+
+
+def source_counts(dispatches_table, destination):
+  counts = {}
+  for source, destinations in dispatches_table.items():
+    if destination in destinations:
+      counts[source] = destinations[destination]
+  return counts
+
+
+def print_top_counts(title, counts, top_count):
+  total = sum(counts.values())
+  if total == 0:
+    print "No dispatches recorded."
+    return
+  print "{} ({} dispatches in total):".format(title, total)
+  for name, count in sorted_counts(counts)[:top_count]:
+    print "{:>12d}\t{:5.1f}%\t{}".format(count, 100.0 * count / total, name)
+
+
+def parse_command_line():
+  command_line_parser = argparse.ArgumentParser(
+      formatter_class=argparse.RawDescriptionHelpFormatter,
+      description=__DESCRIPTION,
+      epilog=__HELP_EPILOGUE)
+  command_line_parser.add_argument(
+      "--top-count", "-n",
+      metavar="N",
+      type=int,
+      default=10,
+      help="print N top entries (default: 10)")
+  command_line_parser.add_argument(
+      "--all", "-a",
+      action="store_true",
+      help="print all entries")
+  mode_group = command_line_parser.add_mutually_exclusive_group()
+  mode_group.add_argument(
+      "--top-pairs", "-p",
+      action="store_true",
+      help="print the most frequent (source, destination) bytecode pairs")
+  mode_group.add_argument(
+      "--top-dispatches-from", "-f",
+      metavar="<bytecode>",
+      help="print the most frequent destinations of dispatches from "
+           "<bytecode>")
+  mode_group.add_argument(
+      "--top-dispatches-to", "-t",
+      metavar="<bytecode>",
+      help="print the most frequent sources of dispatches to <bytecode>")
+  command_line_parser.add_argument(
+      "input_filename",
+      metavar="<input filename>",
+      default="v8.ignition_dispatches_counters.json",
+      nargs="?",
+      help="interpreter dispatch counters file")
+  return command_line_parser.parse_args()
+
+
+def main():
+  program_options = parse_command_line()
+
+  with open(program_options.input_filename) as stream:
+    dispatches_table = json.load(stream)
+
+  if program_options.top_pairs:
+    title = "Top bytecode pairs"
+    counts = pair_counts(dispatches_table)
+  elif program_options.top_dispatches_from:
+    source = program_options.top_dispatches_from
+    title = "Top dispatches from {}".format(source)
+    counts = dispatches_table.get(source, {})
+  elif program_options.top_dispatches_to:
+    destination = program_options.top_dispatches_to
+    title = "Top dispatches to {}".format(destination)
+    counts = source_counts(dispatches_table, destination)
+  else:
+    title = "Top bytecodes"
+    counts = bytecode_counts(dispatches_table)
+
+  top_count = program_options.top_count
+  if program_options.all:
+    top_count = len(counts)
+  print_top_counts(title, counts, top_count)
+
+
+if __name__ == "__main__":
+  main()
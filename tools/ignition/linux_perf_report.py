@@ -0,0 +1,138 @@
+#! /usr/bin/python
+#
+# Copyright 2016 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+#
+
+"""Attributes Linux perf samples to Ignition bytecode handlers."""
+
+import argparse
+import re
+import sys
+
+
+__DESCRIPTION = """
+Processes the output of `perf script` for a d8 run with --ignition and
+--perf-basic-prof, and reports how many samples were taken in each bytecode
+handler. Samples outside the handlers are summarized by kind, which allows
+comparing the time spent interpreting with the time spent in full-codegen
+and optimized code.
+"""
+
+__HELP_EPILOGUE = """
+examples:
+  # Record cycles for a d8 run and report the 20 hottest handlers.
+  $ perf record -g out/x64.release/d8 --ignition --perf-basic-prof test.js
+  $ perf script --fields ip,sym | \\
+      tools/ignition/linux_perf_report.py -n 20
+"""
+
+
+FRAME_RE = re.compile(r"^\s+[0-9a-fA-F]+\s+(?P<symbol>.+?)(\s+\(.*\))?$")
+
+BYTECODE_HANDLER_PREFIX = "BytecodeHandler:"
+
+SAMPLE_KINDS = [
+  # (kind, predicate on the leaf symbol)
+  ("bytecode handlers",
+   lambda symbol: symbol.startswith(BYTECODE_HANDLER_PREFIX)),
+  ("interpreter trampolines",
+   lambda symbol: symbol.startswith("Builtin:Interpreter")),
+  ("optimized code",
+   lambda symbol: symbol.startswith("LazyCompile:*")),
+  ("full-codegen code",
+   lambda symbol: symbol.startswith("LazyCompile:~") or
+                  symbol.startswith("Script:~")),
+  ("stubs and builtins",
+   lambda symbol: symbol.startswith("Stub:") or
+                  symbol.startswith("Builtin:")),
+]
+
+
+def leaf_symbols(perf_stream):
+  """Yields the symbol of the innermost frame of each sample."""
+  in_sample = False
+  for line in perf_stream:
+    if not line.strip():
+      in_sample = False
+      continue
+    match = FRAME_RE.match(line)
+    if match:
+      if not in_sample:
+        in_sample = True
+        yield match.group("symbol")
+      continue
+    # Anything that is not a frame starts a new sample.
+    in_sample = False
+
+
+def classify(symbol):
+  for kind, predicate in SAMPLE_KINDS:
+    if predicate(symbol):
+      return kind
+  return "other"
+
+
+def collect_samples(perf_stream):
+  handler_counts = {}
+  kind_counts = {}
+  for symbol in leaf_symbols(perf_stream):
+    kind = classify(symbol)
+    kind_counts[kind] = kind_counts.get(kind, 0) + 1
+    if symbol.startswith(BYTECODE_HANDLER_PREFIX):
+      handler = symbol[len(BYTECODE_HANDLER_PREFIX):]
+      handler_counts[handler] = handler_counts.get(handler, 0) + 1
+  return handler_counts, kind_counts
+
+
+def print_counts(title, counts, total, top_count=None):
+  print "{}:".format(title)
+  entries = sorted(counts.items(), key=lambda (name, count): count,
+                   reverse=True)
+  if top_count is not None:
+    entries = entries[:top_count]
+  for name, count in entries:
+    print "{:>12d}\t{:5.1f}%\t{}".format(count, 100.0 * count / total, name)
+
+
+def parse_command_line():
+  command_line_parser = argparse.ArgumentParser(
+      formatter_class=argparse.RawDescriptionHelpFormatter,
+      description=__DESCRIPTION,
+      epilog=__HELP_EPILOGUE)
+  command_line_parser.add_argument(
+      "--top-count", "-n",
+      metavar="N",
+      type=int,
+      default=10,
+      help="print N top handlers (default: 10)")
+  command_line_parser.add_argument(
+      "input_filename",
+      metavar="<input filename>",
+      nargs="?",
+      help="output of perf script (default: stdin)")
+  return command_line_parser.parse_args()
+
+
+def main():
+  program_options = parse_command_line()
+
+  if program_options.input_filename:
+    with open(program_options.input_filename) as stream:
+      handler_counts, kind_counts = collect_samples(stream)
+  else:
+    handler_counts, kind_counts = collect_samples(sys.stdin)
+
+  total = sum(kind_counts.values())
+  if total == 0:
+    print "No samples found."
+    return
+  print_counts("Samples by kind", kind_counts, total)
+  print
+  print_counts("Top bytecode handlers", handler_counts, total,
+               program_options.top_count)
+
+
+if __name__ == "__main__":
+  main()